@@ -24,6 +24,7 @@ using std::string;
 #include <AMReX_CONSTANTS.H>
 #include <PeleC.H>
 #include <PeleC_F.H>
+#include <MOLScratch.H>
 #include <Derive_F.H>
 #include <AMReX_VisMF.H>
 #include <AMReX_TagBox.H>
@@ -114,7 +115,7 @@ int          PeleC::n_pfld     = 0;
 
 #include <pelec_defaults.H>
 
-int          PeleC::nGrowTr      = 4;
+int          PeleC::nGrowTr      = 4;  // derived from the active schemes in read_params
 int          PeleC::diffuse_temp = 0;
 int          PeleC::diffuse_enth = 0;
 int          PeleC::diffuse_spec = 0;
@@ -156,6 +157,10 @@ IntVect      PeleC::hydro_tile_size(1024,16,16);
 
 // this will be reset upon restart
 Real         PeleC::previousCPUTimeUsed = 0.0;
+#ifdef REACTIONS
+long         PeleC::chem_cache_bytes = 0;
+int          PeleC::chem_reduced_nclass = 0;
+#endif
 
 Real         PeleC::startCPUTime = 0.0;
 
@@ -185,6 +190,11 @@ PeleC::variableCleanUp ()
 
   desc_lst.clear();
 
+  if (verbose > 0) {
+    MOLScratch::report();
+  }
+  MOLScratch::release();
+
   clear_method_params();
 
   close_transport();
@@ -370,8 +380,18 @@ PeleC::read_params ()
   do_diffuse = diffuse_temp || diffuse_enth || diffuse_spec || diffuse_vel;
   
   // sanity checks
-  if (cfl <= 0.0 || cfl > 1.0) {
-    amrex::Error("Invalid CFL factor; must be between zero and one.");
+  if (do_mol_AD && mol_rk_order != 2 && mol_rk_order != 3 && mol_rk_order != 4) {
+    amrex::Error("Invalid mol_rk_order; must be 2, 3 or 4.");
+  }
+
+  if (do_mol_AD && mol_rk_order != 2 && mol_iters > 1) {
+    amrex::Error("mol_iters > 1 is only supported with mol_rk_order = 2.");
+  }
+
+  // The SSP coefficient of the MOL integrator bounds the usable CFL factor
+  const Real cfl_max = (do_mol_AD && mol_rk_order == 4) ? 6.0 : 1.0;
+  if (cfl <= 0.0 || cfl > cfl_max) {
+    amrex::Error("Invalid CFL factor; must be between zero and one (six with mol_rk_order = 4).");
   }
 
 #ifdef PELEC_USE_MOL
@@ -386,6 +406,36 @@ PeleC::read_params ()
   }
 #endif
 
+  // Ghost cells the MOL right-hand side reads from Sborder, for the active
+  // scheme stack.  This sets the depth of Sborder and of its FillPatch.
+  {
+    int ng_diff = do_diffuse ? 1 : 0;         // face fluxes and tangential derivatives
+    int ng_hydro = 0;
+    if (do_hydro && do_mol_AD) {
+      ng_hydro = (plm_iorder == 1) ? 1 : 2;   // limited slopes in the first ghost cell
+    }
+    int ng_nscbc = 0;
+    if (nscbc_diff == 1) {
+      for (int dir = 0; dir < BL_SPACEDIM; dir++) {
+        if (lo_bc[dir] == 6 || hi_bc[dir] == 6) {
+          ng_nscbc = 4;                       // characteristic fill at UserBC faces
+        }
+      }
+    }
+    int ng_eb = 0;
+#ifdef PELE_USE_EB
+    ng_eb = 4;                                // hybrid divergence and redistribution
+#endif
+    nGrowTr = std::max(std::max(ng_diff, ng_hydro), std::max(ng_nscbc, ng_eb));
+    nGrowTr = std::max(nGrowTr, 1);
+
+    if (verbose > 0) {
+      amrex::Print() << "PeleC::read_params: MOL ghost depth nGrowTr = " << nGrowTr
+                     << " (diffusion " << ng_diff << ", hydro " << ng_hydro
+                     << ", nscbc " << ng_nscbc << ", eb " << ng_eb << ")" << std::endl;
+    }
+  }
+
   // for the moment, ppm_type = 0 does not support ppm_trace_sources --
   // we need to add the momentum sources to the states (and not
   // add it in trans_3d
@@ -446,6 +496,55 @@ PeleC::read_params ()
   // This turns on the lb stuff inside Amr, but we use our own flag to signal whether to gather data
   ppa.query("loadbalance_with_workestimates",do_mol_load_balance);
   ppa.query("loadbalance_with_workestimates",do_react_load_balance);
+
+  // Weight the load balance by the chemistry cost alone
+  if (use_reactions_work_estimate) {
+#ifdef REACTIONS
+    if (!do_react_load_balance) {
+      amrex::Warning("use_reactions_work_estimate needs amr.loadbalance_with_workestimates = 1; ignored");
+    }
+    do_mol_load_balance = false;
+#else
+    amrex::Warning("use_reactions_work_estimate needs a REACTIONS build; ignored");
+#endif
+  }
+
+#ifndef PELEC_USE_FUEGO_EOS
+  if (eos_row_newton) {
+    amrex::Warning("eos_row_newton needs the Fuego EOS; ignored");
+    eos_row_newton = 0;
+  }
+#endif
+
+#ifndef PELEC_USE_FUEGO
+  if (react_init_rates) {
+    amrex::Warning("react_init_rates needs a Fuego mechanism; ignored");
+    react_init_rates = 0;
+  }
+  if (react_activity_tol > 0.0) {
+    amrex::Warning("react_activity_tol needs a Fuego mechanism; ignored");
+    react_activity_tol = 0.0;
+  }
+#endif
+
+  if (chem_rate_sample > 0 && (!react_compact || chem_integrator != 1 || use_isat)) {
+    amrex::Warning("chem_rate_sample needs react_compact = 1, chem_integrator = 1 and use_isat = 0; ignored");
+    chem_rate_sample = 0;
+  }
+
+  if (rebalance_int > 0 && !(do_mol_load_balance || do_react_load_balance)) {
+    amrex::Warning("rebalance_int needs amr.loadbalance_with_workestimates = 1; ignored");
+    rebalance_int = 0;
+  }
+#ifdef AMREX_PARTICLES
+  if (rebalance_int > 0 && do_spray_particles) {
+    amrex::Warning("rebalance_int is not supported with spray particles; ignored");
+    rebalance_int = 0;
+  }
+#endif
+  if (rebalance_alpha <= 0.0 || rebalance_alpha > 1.0) {
+    amrex::Abort("rebalance_alpha must be in (0,1]");
+  }
 }
 
 PeleC::PeleC ()
@@ -553,6 +652,9 @@ PeleC::PeleC (Amr&            papa,
 
 PeleC::~PeleC ()
 {
+#ifdef REACTIONS
+  free_chem_cache();
+#endif
 }
 
 
@@ -816,6 +918,22 @@ PeleC::init (AmrLevel &old)
   {
     React_new.setVal(0);
   }
+
+  // The chemistry warm-start data of the cells still covered by the new
+  // grids is kept; the other cells start cold.  The old level's data is
+  // taken out of the chem_cache_mb budget before the new cache is sized,
+  // so that it is not counted twice; its memory is released after the
+  // copy, so both are allocated at the same time.
+  if (oldlev->chem_cache)
+  {
+    std::unique_ptr<MultiFab> old_cache = std::move(oldlev->chem_cache);
+    oldlev->free_chem_cache();
+
+    MultiFab* cache = get_chem_cache();
+    if (cache != nullptr && cache->nComp() == old_cache->nComp()) {
+      cache->copy(*old_cache, 0, 0, cache->nComp());
+    }
+  }
 #endif
 
   if (do_mol_load_balance || do_react_load_balance)
@@ -902,8 +1020,7 @@ PeleC::estTimeStep (Real dt_old)
 
 
 #ifdef PELE_USE_EB
-    auto const& fact = dynamic_cast<EBFArrayBoxFactory const&>(stateMF.Factory());
-    auto const& flags = fact.getMultiEBCellFlagFab();
+    const EBTileIndex& eb_tiles = ebTileIndex(FabArrayBase::mfiter_tile_size, 0);
 #endif
 
 #ifdef _OPENMP
@@ -915,8 +1032,7 @@ PeleC::estTimeStep (Real dt_old)
         const Box& box = mfi.tilebox();
 
 #ifdef PELE_USE_EB
-        const auto& flag_fab = flags[mfi];
-        FabType typ = flag_fab.getType(box);
+        FabType typ = eb_tiles.type(mfi);
         if (typ == FabType::covered) {
           continue;
         }
@@ -1182,6 +1298,18 @@ PeleC::post_timestep (int iteration)
   MultiFab& S_new = get_new_data(State_Type);
   int ng_pts = 0;
   computeTemp(S_new, ng_pts);
+  reportTempStats();
+
+#ifdef REACTIONS
+  if (level == 0 && use_isat && verbose) {
+    reportIsatStats();
+  }
+#endif
+
+  if (rebalance_int > 0)
+  {
+    sampleBoxCost();
+  }
 
 #ifdef DO_PROBLEM_POST_TIMESTEP
 
@@ -1251,6 +1379,12 @@ PeleC::postCoarseTimeStep (Real cumtime)
 {
   BL_PROFILE("PeleC::postCoarseTimeStep()");
   AmrLevel::postCoarseTimeStep(cumtime);
+
+  // This may replace this level, so nothing may follow it
+  if (level == 0 && rebalance_int > 0)
+  {
+    rebalance(*parent, cumtime);
+  }
 }
 
 void
@@ -1478,8 +1612,7 @@ PeleC::enforce_min_density (MultiFab& S_old, MultiFab& S_new)
   Real eden_added = 0.0;
 
 #ifdef PELE_USE_EB
-  auto const& fact = dynamic_cast<EBFArrayBoxFactory const&>(S_new.Factory());
-  auto const& flags = fact.getMultiEBCellFlagFab();
+  const EBTileIndex& eb_tiles = ebTileIndex(FabArrayBase::mfiter_tile_size, S_new.nGrow());
 #endif
 
 #ifdef _OPENMP
@@ -1490,8 +1623,7 @@ PeleC::enforce_min_density (MultiFab& S_old, MultiFab& S_new)
     const Box& bx = mfi.growntilebox();
 
 #ifdef PELE_USE_EB
-    const auto& flag_fab = flags[mfi];
-    FabType typ = flag_fab.getType(bx);
+    FabType typ = eb_tiles.type(mfi);
     if (typ == FabType::covered)
     {
       continue;
@@ -1895,11 +2027,94 @@ void
 PeleC::init_reactor ()
 {
   pc_reactor_init();
+
+  if (chem_integrator == 1) {
+#ifdef PELEC_USE_FUEGO
+    pc_batch_bdf_init(&chem_rtol, &chem_atol);
+#else
+    amrex::Warning("chem_integrator = 1 needs a Fuego mechanism; using the reactor's integrator");
+    chem_integrator = 0;
+#endif
+  }
+
+  if (chem_jac_reuse && chem_integrator != 1) {
+    amrex::Warning("chem_jac_reuse only applies to the batched integrator (chem_integrator = 1); ignored");
+  }
+
+  if (react_substep) {
+    if (chem_integrator != 0) {
+      amrex::Warning("react_substep only applies to the cell-by-cell integrator (chem_integrator = 0); ignored");
+      react_substep = 0;
+    } else if (react_substep_tol <= 0.0) {
+      amrex::Warning("react_substep needs react_substep_tol > 0; ignored");
+      react_substep = 0;
+    } else {
+      pc_react_substep_init(&react_substep_tol, &react_substep_max);
+    }
+  }
+
+  if (use_isat) {
+    if (chem_integrator != 0) {
+      amrex::Warning("use_isat only applies to the cell-by-cell integrator (chem_integrator = 0); ignored");
+      use_isat = 0;
+    } else {
+      pc_isat_init(&isat_tol, &isat_mb);
+    }
+  }
+}
+
+void
+PeleC::init_reduced_chemistry ()
+{
+  ParmParse pp("pelec");
+
+  Vector<Real> Tmax;
+  pp.queryarr("chem_reduced_T_max", Tmax);
+  const int nclass = Tmax.size();
+
+  if (nclass == 0) return;
+
+  if (chem_integrator != 1) {
+    amrex::Warning("chem_reduced_T_max needs the batched integrator (chem_integrator = 1); ignored");
+    return;
+  }
+
+  Vector<int> active(NumSpec * nclass, 0);
+
+  for (int c = 0; c < nclass; ++c)
+  {
+    const std::string key = "chem_reduced_species_" + std::to_string(c+1);
+    std::vector<std::string> names;
+    pp.getarr(key.c_str(), names);
+
+    for (const auto& name : names)
+    {
+      auto it = std::find(spec_names.begin(), spec_names.end(), name);
+      if (it == spec_names.end()) {
+        amrex::Abort("pelec." + key + ": unknown species " + name);
+      }
+      active[c * NumSpec + (it - spec_names.begin())] = 1;
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+      std::cout << "Reduced chemistry class " << c+1 << ": T < " << Tmax[c] << ", "
+                << names.size() << " of " << NumSpec << " species" << std::endl;
+    }
+  }
+
+  pc_batch_bdf_set_classes(&nclass, Tmax.dataPtr(), active.dataPtr(), &chem_reduced_ytol);
+  chem_reduced_nclass = nclass;
 }
 
 void
 PeleC::close_reactor ()
 {
+  if (use_isat) {
+    pc_isat_close();
+  }
+  if (chem_integrator == 1) {
+    pc_batch_bdf_close();
+  }
   pc_reactor_close();
 }
 #endif
@@ -1987,27 +2202,215 @@ PeleC::computeTemp(MultiFab& S, int ng)
   reset_internal_energy(S, ng);
 
 #ifdef PELE_USE_EB
-  auto const& fact = dynamic_cast<EBFArrayBoxFactory const&>(S.Factory());
-  auto const& flags = fact.getMultiEBCellFlagFab();
+  const EBTileIndex& eb_tiles = ebTileIndex(FabArrayBase::mfiter_tile_size, ng);
 #endif
 
+  long n_solve = 0, n_eval = 0, n_lin = 0, n_fail = 0;
+
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+:n_solve,n_eval,n_lin,n_fail)
 #endif
   for (MFIter mfi(S,true); mfi.isValid(); ++mfi)
   {
     const Box& bx = mfi.growntilebox(ng);
 
 #ifdef PELE_USE_EB
-    const auto& flag_fab = flags[mfi];
-    FabType typ = flag_fab.getType(bx);
+    FabType typ = eb_tiles.type(mfi);
     if (typ == FabType::covered) {
       continue;
     }
 #endif
 
     auto& Sfab = S[mfi];
-    compute_temp(ARLIM_3D(bx.loVect()),ARLIM_3D(bx.hiVect()),BL_TO_FORTRAN_3D(Sfab));
+    int stats[4] = {0, 0, 0, 0};
+    compute_temp(ARLIM_3D(bx.loVect()),ARLIM_3D(bx.hiVect()),BL_TO_FORTRAN_3D(Sfab),
+                 &temp_newton_tol, &temp_lin_tol, stats);
+    n_solve += stats[0];
+    n_eval  += stats[1];
+    n_lin   += stats[2];
+    n_fail  += stats[3];
+  }
+
+  temp_stats[0] += n_solve;
+  temp_stats[1] += n_eval;
+  temp_stats[2] += n_lin;
+  temp_stats[3] += n_fail;
+}
+
+void
+PeleC::computeTempAfterReact(MultiFab& S, int ng)
+{
+#ifdef REACTIONS
+  if (do_react == 1 && keep_react_temp() && ng == 0) {
+    return;
+  }
+#endif
+  computeTemp(S, ng);
+}
+
+void
+PeleC::warmStartTemp(MultiFab& S)
+{
+  if (temp_warm_start) {
+    MultiFab::Copy(S, Sborder, Temp, Temp, 1, 0);
+  }
+}
+
+void
+PeleC::reportTempStats()
+{
+  if (temp_newton_tol > 0 && verbose)
+  {
+    long vals[4] = {temp_stats[0], temp_stats[1], temp_stats[2], temp_stats[3]};
+    ParallelDescriptor::ReduceLongSum(vals, 4, ParallelDescriptor::IOProcessorNumber());
+    amrex::Print() << "[Level " << level << "] T solves: " << vals[0]
+                   << ", EOS evaluations/solve: " << (vals[0] > 0 ? Real(vals[1]) / vals[0] : 0.0)
+                   << ", linearized: " << vals[2]
+                   << ", Newton failures: " << vals[3] << std::endl;
+  }
+  for (int n = 0; n < 4; ++n) {
+    temp_stats[n] = 0;
+  }
+}
+
+#ifdef REACTIONS
+void
+PeleC::reportIsatStats()
+{
+  Real vals[7];
+  pc_isat_stats(vals);
+  ParallelDescriptor::ReduceRealSum(vals, 7, ParallelDescriptor::IOProcessorNumber());
+  const Real nq = std::max(vals[0], Real(1));
+  amrex::Print() << "ISAT: " << vals[0] << " queries, "
+                 << 100 * vals[1] / nq << "% retrieved, "
+                 << 100 * vals[2] / nq << "% grown, "
+                 << 100 * vals[3] / nq << "% added, "
+                 << 100 * vals[4] / nq << "% direct; "
+                 << vals[5] << " records, "
+                 << vals[6] / (1024.0 * 1024.0) << " MB (sums over ranks)" << std::endl;
+}
+#endif
+
+void
+PeleC::sampleBoxCost ()
+{
+  BL_PROFILE("PeleC::sampleBoxCost()");
+
+  const MultiFab& work = get_new_data(Work_Estimate_Type);
+
+  Vector<Real> cost(grids.size(), 0.0);
+  for (MFIter mfi(work); mfi.isValid(); ++mfi) {
+    cost[mfi.index()] = work[mfi].sum(mfi.validbox(), 0);
+  }
+  ParallelDescriptor::ReduceRealSum(cost.dataPtr(), cost.size());
+
+  if (box_cost.size() != cost.size()) {
+    box_cost = cost;
+  } else {
+    for (int i = 0; i < cost.size(); ++i) {
+      box_cost[i] = rebalance_alpha * cost[i] + (1.0 - rebalance_alpha) * box_cost[i];
+    }
+  }
+}
+
+// Cost of the most loaded rank over the mean cost of the ranks
+static Real
+box_cost_imbalance (const Vector<Real>& cost, const DistributionMapping& dm)
+{
+  Vector<Real> load(ParallelDescriptor::NProcs(), 0.0);
+  for (int i = 0; i < cost.size(); ++i) {
+    load[dm[i]] += cost[i];
+  }
+  Real total = 0.0;
+  Real lmax = 0.0;
+  for (int n = 0; n < load.size(); ++n) {
+    total += load[n];
+    lmax = std::max(lmax, load[n]);
+  }
+  return total > 0.0 ? lmax * load.size() / total : 1.0;
+}
+
+void
+PeleC::rebalance (Amr& amr, Real cumtime)
+{
+  BL_PROFILE("PeleC::rebalance()");
+
+  const int nstep = amr.levelSteps(0);
+  if (nstep % rebalance_int != 0 || ParallelDescriptor::NProcs() == 1) return;
+
+  const int finest_level = amr.finestLevel();
+  const bool log = rebalance_datalog >= 0 && rebalance_datalog < amr.NumDataLogs()
+                   && ParallelDescriptor::IOProcessor();
+
+  //
+  // Propose a mapping for each level and keep it if it lowers the imbalance enough.
+  //
+  Vector<DistributionMapping> new_dmap(finest_level+1);
+  int lbase = finest_level+1;
+
+  for (int lev = 0; lev <= finest_level; ++lev)
+  {
+    PeleC& pc_lev = static_cast<PeleC&>(amr.getLevel(lev));
+    new_dmap[lev] = pc_lev.dmap;
+
+    const Vector<Real>& cost = pc_lev.box_cost;
+    if (cost.size() != pc_lev.grids.size()) continue;
+
+    MultiFab weight(pc_lev.grids, pc_lev.dmap, 1, 0);
+    for (MFIter mfi(weight); mfi.isValid(); ++mfi) {
+      weight[mfi].setVal(cost[mfi.index()] / mfi.validbox().numPts());
+    }
+
+    DistributionMapping dm = (rebalance_strategy == 1)
+      ? DistributionMapping::makeSFC(weight)
+      : DistributionMapping::makeKnapSack(weight);
+
+    const Real imb_old = box_cost_imbalance(cost, pc_lev.dmap);
+    const Real imb_new = box_cost_imbalance(cost, dm);
+    const bool migrate = imb_old - imb_new > rebalance_threshold * imb_old;
+
+    if (migrate) {
+      new_dmap[lev] = dm;
+      lbase = std::min(lbase, lev);
+    }
+
+    if (verbose) {
+      amrex::Print() << "PeleC::rebalance: level " << lev << " imbalance " << imb_old
+                     << " -> " << imb_new << (migrate ? ", remapped" : ", kept") << std::endl;
+    }
+
+    if (log) {
+      std::ostream& data_log = amr.DataLog(rebalance_datalog);
+      if (data_log.good()) {
+        if (data_log.tellp() == 0) {
+          data_log << "#   step          time lev imb_before     imb_after  moved" << std::endl;
+        }
+        data_log << std::setw(8) << nstep << std::setw(14) << std::setprecision(6) << cumtime
+                 << std::setw(4) << lev << std::setw(14) << imb_old << std::setw(14) << imb_new
+                 << std::setw(4) << migrate << std::endl;
+      }
+    }
+  }
+
+  if (lbase > finest_level) return;
+
+  //
+  // Rebuild the remapped levels and those above them, whose flux registers
+  // refer to the mapping of the level below.  The data is copied from the
+  // old level, as by regrid on unchanged grids.  Level lbase goes last
+  // since it may be the calling level.
+  //
+  for (int lev = finest_level; lev >= lbase; --lev)
+  {
+    PeleC& old = static_cast<PeleC&>(amr.getLevel(lev));
+
+    amr.SetDistributionMap(lev, new_dmap[lev]);
+
+    PeleC* a = new PeleC(amr, lev, amr.Geom(lev), old.boxArray(), new_dmap[lev], cumtime);
+    a->init(old);
+    a->box_cost = old.box_cost;
+
+    amr.getAmrLevels()[lev].reset(a);
   }
 }
 
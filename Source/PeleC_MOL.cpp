@@ -1,5 +1,7 @@
 #include <PeleC.H>
 #include <PeleC_F.H>
+#include <MOLScratch.H>
+#include <MOLHypFlux.H>
 
 using std::string;
 using namespace amrex;
@@ -19,7 +21,8 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
                      amrex::MultiFab&       MOLSrcTerm,
                      amrex::Real            time,
                      amrex::Real            dt,
-                     amrex::Real            flux_factor) {
+                     amrex::Real            flux_factor,
+                     int                    tile_set) {
   BL_PROFILE("PeleC::getMOLSrcTerm()");
   BL_PROFILE_VAR_NS("diffusion_stuff", diff);
   if (diffuse_temp == 0
@@ -48,7 +51,8 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
      a. Evaluate tangential derivatives for strain terms, over all cells
      b. Replace these with versions that avoid covered cells, if present
      c. Evaluate face-centered diffusion fluxes, and their divergence
-     d. Zero fluxes and divergence after the fact if subset of components have diffuse shut off
+     d. Only the flux groups (velocity, energy, species) that are switched on are built,
+     along with the transport coefficients they need; the others are left at zero
      (this allows that T be diffused alone, in order to support simple tests)
      e. Compute flux into EB, for temperature (heat flux, when Dirichlet) and momentum
      (when no-slip wall)
@@ -80,6 +84,19 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
   int dComp_xi = dComp_mu + 1;
   int dComp_lambda = dComp_xi + 1;
   int nCompTr = dComp_lambda + 1;
+
+  // Transport coefficient ranges needed by the diffusion flux groups that are on
+  int nTrGroups = 0;
+  int trGroupComp[3], trGroupNComp[3];
+  if (diffuse_spec) {
+    trGroupComp[nTrGroups] = dComp_rhoD;   trGroupNComp[nTrGroups++] = NumSpec;
+  }
+  if (diffuse_vel) {
+    trGroupComp[nTrGroups] = dComp_mu;     trGroupNComp[nTrGroups++] = 2;  // mu, xi
+  }
+  if (diffuse_temp || diffuse_enth) {
+    trGroupComp[nTrGroups] = dComp_lambda; trGroupNComp[nTrGroups++] = 1;
+  }
   int do_harmonic = 1;  // TODO: parmparse this
   const Real* dx = geom.CellSize();
 
@@ -90,11 +107,11 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
   std::array<Real, BL_SPACEDIM> dxD = {D_DECL(dx1, dx1, dx1)};
   const Real *dxDp = &(dxD[0]);
 
-#ifdef PELE_USE_EB
   MultiFab* cost = nullptr;
 
   if (do_mol_load_balance) cost = &(get_new_data(Work_Estimate_Type));
 
+#ifdef PELE_USE_EB
   EBFluxRegister* fr_as_crse = nullptr;
   if (do_reflux && level < parent->finestLevel()) {
     fr_as_crse = &getFluxReg(level+1);
@@ -109,15 +126,29 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
   int as_fine = (fr_as_fine != nullptr);
 #endif
 
+#ifdef PELE_USE_EB
+  // EB types of the tiles below, over their boxes grown by S.nGrow()-1 (cbox)
+  const EBTileIndex& eb_tiles = ebTileIndex(hydro_tile_size, S.nGrow()-1, true);
+#endif
+
+  MOLScratch::reserve_threads();
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
   {
-    FArrayBox Qfab, Qaux, coeff_cc, Dterm;
-    IArrayBox bcMask[BL_SPACEDIM];
-    FArrayBox coeff_ec[BL_SPACEDIM], flux_ec[BL_SPACEDIM],
-      tander_ec[BL_SPACEDIM], flatn;
-    FArrayBox dm_as_fine(Box::TheUnitBox(), NUM_STATE);
+    // Tile temporaries live in a per-thread arena that persists across calls
+    MOLScratch& scratch = MOLScratch::get();
+    FArrayBox& Qfab     = scratch.fab(MOLScratch::Q);
+    FArrayBox& Qaux     = scratch.fab(MOLScratch::Qaux);
+    FArrayBox& coeff_cc = scratch.fab(MOLScratch::CoeffCC);
+    FArrayBox& Dterm    = scratch.fab(MOLScratch::Dterm);
+    FArrayBox& flatn    = scratch.fab(MOLScratch::Flatn);
+    IArrayBox* bcMask    = &scratch.ifab(MOLScratch::BCMask);
+    FArrayBox* coeff_ec  = &scratch.fab(MOLScratch::CoeffEC);
+    FArrayBox* flux_ec   = &scratch.fab(MOLScratch::FluxEC);
+    FArrayBox* tander_ec = &scratch.fab(MOLScratch::TanderEC);
+    FArrayBox& dm_as_fine = scratch.resize(MOLScratch::DmAsFine, Box::TheUnitBox(), NUM_STATE);
     FArrayBox fab_drho_as_crse(Box::TheUnitBox(), NUM_STATE);
     IArrayBox fab_rrflag_as_crse(Box::TheUnitBox());
     
@@ -132,15 +163,18 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
 
     for (MFIter mfi(S, MFItInfo().EnableTiling(hydro_tile_size).SetDynamic(true));
          mfi.isValid(); ++mfi) {
-#ifdef PELE_USE_EB
       Real wt = ParallelDescriptor::second();
-#endif
 
       const Box  vbox = mfi.tilebox();
       int ng = S.nGrow();
       const Box  gbox = amrex::grow(vbox,ng);
       const Box  cbox = amrex::grow(vbox,ng-1);
       const Box& dbox = geom.Domain();
+
+      if (tile_set != MOLAllTiles) {
+        const bool interior = mfi.validbox().contains(gbox);
+        if (interior != (tile_set == MOLInteriorTiles)) continue;
+      }
       
       const int* lo = vbox.loVect();
 	    const int* hi = vbox.hiVect();
@@ -149,7 +183,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
       const EBFArrayBox& Sfab = static_cast<const EBFArrayBox&>(S[mfi]);
 
       const auto& flag_fab = Sfab.getEBCellFlagFab();
-      FabType typ = flag_fab.getType(cbox);
+      FabType typ = eb_tiles.type(mfi);
       if (typ == FabType::covered) {
         MOLSrcTerm[mfi].setVal(0, vbox, 0, NUM_STATE);
 
@@ -162,17 +196,35 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
       }
 
       int local_i = mfi.LocalIndex();
-      int Ncut = no_eb_in_domain ? 0 : sv_eb_bndry_grad_stencil[local_i].size();
+      int Ncut = no_eb_in_domain ? 0 : sv_eb_bndry_grad_stencil.size(local_i);
+
+      // Fluxes are needed beyond the tile only for the EB redistribution
+      const Box& fbox = (typ == FabType::regular) ? vbox : cbox;
 #else
       const FArrayBox& Sfab = S[mfi];
+      const Box& fbox = vbox;
 #endif
 
       BL_PROFILE_VAR_START(diff);
-      Qfab.resize(gbox, QVAR);
+      scratch.resize(MOLScratch::Q, gbox, QVAR);
       int nqaux = NQAUX > 0 ? NQAUX : 1;
-      Qaux.resize(gbox, nqaux);
+      scratch.resize(MOLScratch::Qaux, gbox, nqaux);
+      scratch.resize(MOLScratch::CoeffCC, gbox, nCompTr);
+      for (int d=0; d<BL_SPACEDIM; ++d) {
+        scratch.resize(MOLScratch::CoeffEC + d, amrex::surroundingNodes(cbox,d), nCompTr);
+      }
+
       // Get primitives, Q, including (Y, T, p, rho) from conserved state
-      // required for D term
+      // required for D term, and the transport coefficients; NSCBC modifies
+      // Q before the coefficients are evaluated, so it needs separate passes
+      const bool fuse_tr = mol_fused_transport && nscbc_diff == 0;
+      if (fuse_tr)
+      {
+        getMOLPrimAndTransport(Sfab, gbox, cbox, Qfab, Qaux, coeff_cc, coeff_ec,
+                               nTrGroups, trGroupComp, trGroupNComp,
+                               dComp_rhoD, dComp_mu, dComp_xi, dComp_lambda, do_harmonic);
+      }
+      else
       {
         BL_PROFILE("PeleC::ctoprim call");
         ctoprim(ARLIM_3D(gbox.loVect()), ARLIM_3D(gbox.hiVect()),
@@ -190,7 +242,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
           if (i!=d) TestBox.grow(d,1);
         }
         
-		    bcMask[i].resize(TestBox,1);
+		    scratch.iresize(MOLScratch::BCMask + i, TestBox, 1);
         bcMask[i].setVal(0);
 	    }
       
@@ -215,50 +267,52 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
       }
       
       // Compute transport coefficients, coincident with Q
+      if (!fuse_tr)
       {
         BL_PROFILE("PeleC::get_transport_coeffs call");
-        coeff_cc.resize(gbox, nCompTr);
-        get_transport_coeffs(ARLIM_3D(gbox.loVect()),
-                             ARLIM_3D(gbox.hiVect()),
-                             BL_TO_FORTRAN_N_3D(Qfab, cQFS),
-                             BL_TO_FORTRAN_N_3D(Qfab, cQTEMP),
-                             BL_TO_FORTRAN_N_3D(Qfab, cQRHO),
-                             BL_TO_FORTRAN_N_3D(coeff_cc, dComp_rhoD),
-                             BL_TO_FORTRAN_N_3D(coeff_cc, dComp_mu),
-                             BL_TO_FORTRAN_N_3D(coeff_cc, dComp_xi),
-                             BL_TO_FORTRAN_N_3D(coeff_cc, dComp_lambda));
+        pc_get_transport_coeffs(ARLIM_3D(gbox.loVect()),
+                                ARLIM_3D(gbox.hiVect()),
+                                BL_TO_FORTRAN_N_3D(Qfab, cQFS),
+                                BL_TO_FORTRAN_N_3D(Qfab, cQTEMP),
+                                BL_TO_FORTRAN_N_3D(Qfab, cQRHO),
+                                BL_TO_FORTRAN_N_3D(coeff_cc, dComp_rhoD),
+                                BL_TO_FORTRAN_N_3D(coeff_cc, dComp_mu),
+                                BL_TO_FORTRAN_N_3D(coeff_cc, dComp_xi),
+                                BL_TO_FORTRAN_N_3D(coeff_cc, dComp_lambda));
       }
 
       // Container on grown region, for hybrid divergence & redistribution
-      Dterm.resize(cbox, NUM_STATE);
+      scratch.resize(MOLScratch::Dterm, cbox, NUM_STATE);
 
       for (int d=0; d<BL_SPACEDIM; ++d) {
         Box ebox = amrex::surroundingNodes(cbox,d);
-        coeff_ec[d].resize(ebox,nCompTr);
-        flux_ec[d].resize(ebox,NUM_STATE);
+        scratch.resize(MOLScratch::FluxEC + d, ebox, NUM_STATE);
         flux_ec[d].setVal(0);
-        // Get face-centered transport coefficients
+        // Get face-centered transport coefficients, only those that were evaluated
+        if (!fuse_tr)
         {
           BL_PROFILE("PeleC::pc_move_transport_coeffs_to_ec call");
-          pc_move_transport_coeffs_to_ec(ARLIM_3D(cbox.loVect()),
-                                         ARLIM_3D(cbox.hiVect()),
-                                         ARLIM_3D(dbox.loVect()),
-                                         ARLIM_3D(dbox.hiVect()),
-                                         BL_TO_FORTRAN_3D(coeff_cc),
-                                         BL_TO_FORTRAN_3D(coeff_ec[d]),
-                                         &d, &nCompTr, &do_harmonic);
+          for (int g = 0; g < nTrGroups; ++g) {
+            pc_move_transport_coeffs_to_ec(ARLIM_3D(ebox.loVect()),
+                                           ARLIM_3D(ebox.hiVect()),
+                                           ARLIM_3D(dbox.loVect()),
+                                           ARLIM_3D(dbox.hiVect()),
+                                           BL_TO_FORTRAN_N_3D(coeff_cc, trGroupComp[g]),
+                                           BL_TO_FORTRAN_N_3D(coeff_ec[d], trGroupComp[g]),
+                                           &d, &trGroupNComp[g], &do_harmonic);
+          }
         }
 #if (BL_SPACEDIM > 1)
         int nCompTan = AMREX_D_PICK(1, 2, 6);
-        tander_ec[d].resize(ebox, nCompTan); tander_ec[d].setVal(0);
+        scratch.resize(MOLScratch::TanderEC + d, ebox, nCompTan); tander_ec[d].setVal(0);
         // Tangential derivatives on faces only needed for velocity diffusion
         if (diffuse_vel == 0) {
           tander_ec[d].setVal(0);
         } else {
           {
             BL_PROFILE("PeleC::pc_compute_tangential_vel_derivs call");
-            pc_compute_tangential_vel_derivs(cbox.loVect(),
-                                             cbox.hiVect(),
+            pc_compute_tangential_vel_derivs(fbox.loVect(),
+                                             fbox.hiVect(),
                                              dbox.loVect(),
                                              dbox.hiVect(),
                                              BL_TO_FORTRAN_ANYD(Qfab),
@@ -274,7 +328,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
                                                   cbox.hiVect(),
                                                   dbox.loVect(),
                                                   dbox.hiVect(),
-                                                  sv_eb_bndry_geom[mfi.LocalIndex()].data(),
+                                                  sv_eb_bndry_geom.data(mfi.LocalIndex()),
                                                   &Ncut,
                                                   BL_TO_FORTRAN_ANYD(Qfab),
                                                   BL_TO_FORTRAN_ANYD(tander_ec[d]),
@@ -292,8 +346,8 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
       // Compute extensive diffusion fluxes, F.A and (1/Vol).Div(F.A)
       {
         BL_PROFILE("PeleC::pc_diffterm()");
-        pc_diffterm(cbox.loVect(),
-                    cbox.hiVect(),
+        pc_diffterm(fbox.loVect(),
+                    fbox.hiVect(),
                     dbox.loVect(),
                     dbox.hiVect(),
                     BL_TO_FORTRAN_ANYD(Qfab),
@@ -329,35 +383,6 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
                     geom.CellSize());
       }
 
-      // Shut off unwanted diffusion after the fact
-      //    ick! Under normal conditions, you either have diffusion on all or
-      //      none, so this shouldn't be done this way.  However, the regression
-      //      test for diffusion works by diffusing only temperature through
-      //      this process.  Ideally, we'd redo that test to diffuse a passive
-      //      scalar instead....
-          
-      if (diffuse_temp == 0 && diffuse_enth == 0) {
-        Dterm.setVal(0, Eden);
-        Dterm.setVal(0, Eint);
-        for (int d = 0; d < BL_SPACEDIM; d++) {
-          flux_ec[d].setVal(0, Eden);
-          flux_ec[d].setVal(0, Eint);
-        }
-      }
-      if (diffuse_spec == 0) {
-        Dterm.setVal(0, Dterm.box(), FirstSpec, NumSpec);
-        for (int d = 0; d < BL_SPACEDIM ; d++) {
-          flux_ec[d].setVal(0, flux_ec[d].box(), FirstSpec, NumSpec);
-        }
-      }
-
-      if (diffuse_vel  == 0) {
-        Dterm.setVal(0, Dterm.box(), Xmom, 3);
-        for (int d = 0; d < BL_SPACEDIM; d++) {
-          flux_ec[d].setVal(0, flux_ec[d].box(), Xmom, 3);
-        }
-      }
-
 #ifdef PELE_USE_EB
       //  Set extensive flux at embedded boundary, potentially
       //  non-zero only for heat flux on isothermal boundaries,
@@ -379,7 +404,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
           {
             BL_PROFILE("PeleC::pc_apply_eb_boundry_flux_stencil call");
             pc_apply_eb_boundry_flux_stencil(BL_TO_FORTRAN_BOX(box_to_apply),
-                                             sv_eb_bndry_grad_stencil[local_i].data(),
+                                             sv_eb_bndry_grad_stencil.data(local_i),
                                              &Ncut,
                                              BL_TO_FORTRAN_N_ANYD(Qfab, cQTEMP),
                                              BL_TO_FORTRAN_N_ANYD(coeff_cc, dComp_lambda),
@@ -398,9 +423,9 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
           {
             BL_PROFILE("PeleC::pc_apply_eb_boundry_visc_flux_stencil call");
             pc_apply_eb_boundry_visc_flux_stencil(BL_TO_FORTRAN_BOX(box_to_apply),
-                                                  sv_eb_bndry_grad_stencil[local_i].data(),
+                                                  sv_eb_bndry_grad_stencil.data(local_i),
                                                   &Ncut,
-                                                  sv_eb_bndry_geom[local_i].data(), &Ncut,
+                                                  sv_eb_bndry_geom.data(local_i), &Ncut,
                                                   BL_TO_FORTRAN_N_ANYD(Qfab, cQU),
                                                   BL_TO_FORTRAN_N_ANYD(coeff_cc, dComp_mu),
                                                   BL_TO_FORTRAN_N_ANYD(coeff_cc, dComp_xi),
@@ -425,40 +450,65 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
       */
       if (do_hydro && do_mol_AD) 
       {
-        flatn.resize(cbox,1);
+        scratch.resize(MOLScratch::Flatn, cbox, 1);
         flatn.setVal(1.0);  // Set flattening to 1.0
 #ifdef PELEC_USE_EB
         int nFlux = sv_eb_flux.size()==0 ? 0 : sv_eb_flux[local_i].numPts();
-        const EBBndryGeom* sv_ebbg_ptr = (Ncut>0 ? sv_eb_bndry_geom[local_i].data() : 0);
+        const EBBndryGeom* sv_ebbg_ptr = (Ncut>0 ? sv_eb_bndry_geom.data(local_i) : 0);
         Real* sv_eb_flux_ptr = (nFlux>0 ? sv_eb_flux[local_i].dataPtr() : 0);
+        // Regular tiles take the kernels without EB flags, stencils or wall flux
+        const int eb_tile = (typ != FabType::regular);
+#else
+        const int eb_tile = 0;
 #endif
 
         { // Get face-centered hyperbolic fluxes and their divergences.
           // Get hyp flux at EB wall
-          BL_PROFILE("PeleC::pc_hyp_mol_flux call");
-          pc_hyp_mol_flux(vbox.loVect(), vbox.hiVect(),
-                          geom.Domain().loVect(), geom.Domain().hiVect(),
-                          BL_TO_FORTRAN_3D(Qfab),
-                          BL_TO_FORTRAN_3D(Qaux),
-                          BL_TO_FORTRAN_ANYD(area[0][mfi]),
-                          BL_TO_FORTRAN_3D(flux_ec[0]),
+          bool done = false;
+#if (BL_SPACEDIM == 3)
+          if (mol_flux_kernel == 1)
+          {
+            BL_PROFILE("PeleC::MOLHypFlux::hyp_mol_flux call");
+            const MOLHypFlux::Idx ix = {cQRHO, cQU, cQPRES, cQFS, cQC, cQCSML,
+                                        Density, Xmom, Eden, Eint, FirstSpec, NUM_STATE};
+            const FArrayBox* area_fab[BL_SPACEDIM] = {&area[0][mfi], &area[1][mfi], &area[2][mfi]};
+            FArrayBox* flux_fab[BL_SPACEDIM] = {&flux_ec[0], &flux_ec[1], &flux_ec[2]};
+            FArrayBox& dq = scratch.resize(MOLScratch::Slope, amrex::grow(vbox, MOLHypFlux::nextra(eb_tile)), 4+NumSpec);
+            done = MOLHypFlux::dispatch(NumSpec, eb_tile, vbox, Qfab, Qaux, area_fab, flux_fab,
+                                        volume[mfi], Dterm, dq,
+#ifdef PELEC_USE_EB
+                                        flag_fab, sv_ebbg_ptr, Ncut, sv_eb_flux_ptr, nFlux,
+#endif
+                                        ix, plm_iorder, small_dens, small_pres, geom.CellSize());
+          }
+#endif
+          if (!done)
+          {
+            BL_PROFILE("PeleC::pc_hyp_mol_flux call");
+            pc_hyp_mol_flux(vbox.loVect(), vbox.hiVect(),
+                            geom.Domain().loVect(), geom.Domain().hiVect(),
+                            BL_TO_FORTRAN_3D(Qfab),
+                            BL_TO_FORTRAN_3D(Qaux),
+                            BL_TO_FORTRAN_ANYD(area[0][mfi]),
+                            BL_TO_FORTRAN_3D(flux_ec[0]),
 #if (BL_SPACEDIM > 1)
-                          BL_TO_FORTRAN_ANYD(area[1][mfi]),
-                          BL_TO_FORTRAN_3D(flux_ec[1]),
+                            BL_TO_FORTRAN_ANYD(area[1][mfi]),
+                            BL_TO_FORTRAN_3D(flux_ec[1]),
 #if (BL_SPACEDIM > 2)
-                          BL_TO_FORTRAN_ANYD(area[2][mfi]),
-                          BL_TO_FORTRAN_3D(flux_ec[2]),
+                            BL_TO_FORTRAN_ANYD(area[2][mfi]),
+                            BL_TO_FORTRAN_3D(flux_ec[2]),
 #endif
 #endif
-                          BL_TO_FORTRAN_3D(flatn),
-                          BL_TO_FORTRAN_ANYD(volume[mfi]),
-                          BL_TO_FORTRAN_3D(Dterm),
+                            BL_TO_FORTRAN_3D(flatn),
+                            BL_TO_FORTRAN_ANYD(volume[mfi]),
+                            BL_TO_FORTRAN_3D(Dterm),
 #ifdef PELEC_USE_EB
-                          BL_TO_FORTRAN_ANYD(flag_fab),
-                          sv_ebbg_ptr, &Ncut,
-                          sv_eb_flux_ptr, &nFlux,
+                            BL_TO_FORTRAN_ANYD(flag_fab),
+                            sv_ebbg_ptr, &Ncut,
+                            sv_eb_flux_ptr, &nFlux, &eb_tile,
 #endif
-                          geom.CellSize());
+                            geom.CellSize());
+          }
         }
       }
 #endif
@@ -473,7 +523,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
          */
 
         for (int idir=0; idir < BL_SPACEDIM; ++idir) {
-          int Nsten = flux_interp_stencil[idir][local_i].size();
+          int Nsten = flux_interp_stencil[idir].size(local_i);
           int in_place = 1;
           const Box valid_interped_flux_box =
             Box(amrex::grow(vbox, 2)).surroundingNodes(idir);
@@ -481,7 +531,7 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
             BL_PROFILE("PeleC::pc_apply_face_stencil call");
             pc_apply_face_stencil(BL_TO_FORTRAN_BOX(valid_interped_flux_box),
                                   BL_TO_FORTRAN_BOX(stencil_volume_box),
-                                  flux_interp_stencil[idir][local_i].data(),
+                                  flux_interp_stencil[idir].data(local_i),
                                   &Nsten, &idir,
                                   BL_TO_FORTRAN_ANYD(flux_ec[idir]),
                                   BL_TO_FORTRAN_ANYD(flux_ec[idir]),
@@ -517,11 +567,11 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
             fr_as_crse->getCrseFlag(mfi) : &fab_rrflag_as_crse;
 
           if (fr_as_fine) {
-            dm_as_fine.resize(amrex::grow(vbox, 1), NUM_STATE);
+            scratch.resize(MOLScratch::DmAsFine, amrex::grow(vbox, 1), NUM_STATE);
           }
           BL_PROFILE("PeleC::pc_fix_div_and_redistribute call");
           pc_fix_div_and_redistribute(BL_TO_FORTRAN_BOX(vbox),
-                                      sv_eb_bndry_geom[local_i].data(), &Ncut,
+                                      sv_eb_bndry_geom.data(local_i), &Ncut,
                                       BL_TO_FORTRAN_ANYD(flag_fab),
                                       D_DECL(BL_TO_FORTRAN_ANYD(flux_ec[0]),
                                              BL_TO_FORTRAN_ANYD(flux_ec[1]),
@@ -545,33 +595,23 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
           }
 
           if (fr_as_crse) {
-#if (BL_SPACEDIM > 2)
             fr_as_crse->CrseAdd(mfi,
                                 {D_DECL(&flux_ec[0], &flux_ec[1], &flux_ec[2])},
                                 dxDp, dt, vfrac[mfi],
-                                {&((*areafrac[0])[mfi]),
-                                    &((*areafrac[1])[mfi]),
-                                    &((*areafrac[2])[mfi])});
-#else
-            // TODO: EBfluxregisters are designed only for 3D, need for 2D
-            Print() << "WARNING:Re redistribution crseadd for EB not implemented\n";
-#endif
+                                {D_DECL(&((*areafrac[0])[mfi]),
+                                        &((*areafrac[1])[mfi]),
+                                        &((*areafrac[2])[mfi]))});
           }
 
           if (fr_as_fine) {
-#if (BL_SPACEDIM > 2)
             fr_as_fine->FineAdd(mfi,
                                 {D_DECL(&flux_ec[0], &flux_ec[1], &flux_ec[2])},
                                 dxDp, dt,
                                 vfrac[mfi],
-                                {&((*areafrac[0])[mfi]),
-                                    &((*areafrac[1])[mfi]),
-                                    &((*areafrac[2])[mfi])},
+                                {D_DECL(&((*areafrac[0])[mfi]),
+                                        &((*areafrac[1])[mfi]),
+                                        &((*areafrac[2])[mfi]))},
                                 dm_as_fine);
-#else
-            // TODO: EBfluxregisters are designed only for 3D, need for 2D
-            Print() << "WARNING:Re redistribution fineadd for EB not implemented in 2D\n";
-#endif
           }
         }
       } else if (typ != FabType::regular) {  // Single valued if loop
@@ -606,17 +646,15 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
           }
         }
 
-#ifdef PELEC_USE_EB
       if (do_mol_load_balance) {
         wt = (ParallelDescriptor::second() - wt) / vbox.d_numPts();
         (*cost)[mfi].plus(wt, vbox);
       }
-#endif
     }  // End of MFIter scope
   }  // End of OMP scope
 
-  // Extrapolate to ghost cells
-  if (MOLSrcTerm.nGrow() > 0) {
+  // Extrapolate to ghost cells, once all tiles are done
+  if (MOLSrcTerm.nGrow() > 0 && tile_set != MOLInteriorTiles) {
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -636,3 +674,127 @@ PeleC::getMOLSrcTerm(const amrex::MultiFab& S,
     }
   }
 }
+
+// **********************************************************************************************
+void
+PeleC::fillPatchAndGetMOLSrcTerm(amrex::Real      fill_time,
+                                 amrex::MultiFab& MOLSrcTerm,
+                                 amrex::Real      time,
+                                 amrex::Real      dt,
+                                 amrex::Real      flux_factor) {
+  BL_PROFILE("PeleC::fillPatchAndGetMOLSrcTerm()");
+
+  if (mol_overlap_comm == 0 || level > 0) {
+    FillPatch(*this, Sborder, nGrowTr, fill_time, State_Type, 0, NUM_STATE);
+    getMOLSrcTerm(Sborder, MOLSrcTerm, time, dt, flux_factor);
+    return;
+  }
+
+  /**
+     On level 0 there is no coarse data to interpolate, so FillPatch reduces
+     to a copy of the valid data, a same-level ghost exchange and a physical
+     boundary fill.  Post the exchange, work on the tiles whose stencil stays
+     inside their own box while the messages are in flight, then finish the
+     exchange and do the tiles that read ghost cells.
+  */
+  BL_PROFILE_VAR("PeleC::MOL_halo_post", halo_post);
+  Real t0 = ParallelDescriptor::second();
+  MultiFab::Copy(Sborder, get_data(State_Type, fill_time), 0, 0, NUM_STATE, 0);
+  Sborder.FillBoundary_nowait(geom.periodicity());
+  BL_PROFILE_VAR_STOP(halo_post);
+
+  BL_PROFILE_VAR("PeleC::MOL_interior_tiles", interior_tiles);
+  Real t1 = ParallelDescriptor::second();
+  getMOLSrcTerm(Sborder, MOLSrcTerm, time, dt, flux_factor, MOLInteriorTiles);
+  BL_PROFILE_VAR_STOP(interior_tiles);
+
+  BL_PROFILE_VAR("PeleC::MOL_halo_wait", halo_wait);
+  Real t2 = ParallelDescriptor::second();
+  Sborder.FillBoundary_finish();
+  if (!geom.isAllPeriodic()) {
+    // The physical boundary fill of FillPatch, with its treatment of the
+    // ghost cells that are periodic images of cells outside the domain
+    StateDataPhysBCFunct physbcf(state[State_Type], 0, geom);
+    physbcf(Sborder, 0, NUM_STATE, Sborder.nGrowVect(), fill_time, 0);
+  }
+  BL_PROFILE_VAR_STOP(halo_wait);
+
+  BL_PROFILE_VAR("PeleC::MOL_boundary_tiles", boundary_tiles);
+  Real t3 = ParallelDescriptor::second();
+  getMOLSrcTerm(Sborder, MOLSrcTerm, time, dt, flux_factor, MOLBoundaryTiles);
+  Real t4 = ParallelDescriptor::second();
+  BL_PROFILE_VAR_STOP(boundary_tiles);
+
+  if (verbose > 1) {
+    Real tm[4] = {t1 - t0, t2 - t1, t3 - t2, t4 - t3};
+    ParallelDescriptor::ReduceRealMax(tm, 4, ParallelDescriptor::IOProcessorNumber());
+    amrex::Print() << "... MOL overlap (max over ranks): post " << tm[0]
+                   << " interior " << tm[1]
+                   << " wait " << tm[2]
+                   << " boundary " << tm[3] << std::endl;
+  }
+}
+
+// **********************************************************************************************
+// Primitive state, Qaux and the transport coefficients on gbox, and the face coefficients on
+// the faces of cbox, in one sweep over the planes of gbox normal to the last direction: each
+// plane is converted and its coefficients evaluated while it is in cache, and the faces whose
+// two cells are then available are filled right away.
+void
+PeleC::getMOLPrimAndTransport(const amrex::FArrayBox& S,
+                              const amrex::Box&       gbox,
+                              const amrex::Box&       cbox,
+                              amrex::FArrayBox&       Q,
+                              amrex::FArrayBox&       Qaux,
+                              amrex::FArrayBox&       coeff_cc,
+                              amrex::FArrayBox*       coeff_ec,
+                              int                     nTrGroups,
+                              const int*              trGroupComp,
+                              const int*              trGroupNComp,
+                              int dComp_rhoD, int dComp_mu, int dComp_xi, int dComp_lambda,
+                              int                     do_harmonic) {
+  BL_PROFILE("PeleC::getMOLPrimAndTransport()");
+
+  const int sd = BL_SPACEDIM - 1;
+  const Box& dbox = geom.Domain();
+
+  for (int p = gbox.smallEnd(sd); p <= gbox.bigEnd(sd); ++p)
+  {
+    Box pbox(gbox);
+    pbox.setSmall(sd, p);
+    pbox.setBig(sd, p);
+
+    ctoprim(ARLIM_3D(pbox.loVect()), ARLIM_3D(pbox.hiVect()),
+            S.dataPtr(), ARLIM_3D(S.loVect()), ARLIM_3D(S.hiVect()),
+            Q.dataPtr(), ARLIM_3D(Q.loVect()), ARLIM_3D(Q.hiVect()),
+            Qaux.dataPtr(), ARLIM_3D(Qaux.loVect()), ARLIM_3D(Qaux.hiVect()));
+
+    pc_get_transport_coeffs(ARLIM_3D(pbox.loVect()),
+                            ARLIM_3D(pbox.hiVect()),
+                            BL_TO_FORTRAN_N_3D(Q, cQFS),
+                            BL_TO_FORTRAN_N_3D(Q, cQTEMP),
+                            BL_TO_FORTRAN_N_3D(Q, cQRHO),
+                            BL_TO_FORTRAN_N_3D(coeff_cc, dComp_rhoD),
+                            BL_TO_FORTRAN_N_3D(coeff_cc, dComp_mu),
+                            BL_TO_FORTRAN_N_3D(coeff_cc, dComp_xi),
+                            BL_TO_FORTRAN_N_3D(coeff_cc, dComp_lambda));
+
+    // Faces within plane p, and (for d = sd) the faces between planes p-1 and p
+    for (int d = 0; d < BL_SPACEDIM; ++d)
+    {
+      Box fbox = amrex::surroundingNodes(cbox, d);
+      if (p < fbox.smallEnd(sd) || p > fbox.bigEnd(sd)) continue;
+      fbox.setSmall(sd, p);
+      fbox.setBig(sd, p);
+      for (int g = 0; g < nTrGroups; ++g) {
+        pc_move_transport_coeffs_to_ec(ARLIM_3D(fbox.loVect()),
+                                       ARLIM_3D(fbox.hiVect()),
+                                       ARLIM_3D(dbox.loVect()),
+                                       ARLIM_3D(dbox.hiVect()),
+                                       BL_TO_FORTRAN_N_3D(coeff_cc, trGroupComp[g]),
+                                       BL_TO_FORTRAN_N_3D(coeff_ec[d], trGroupComp[g]),
+                                       &d, &trGroupNComp[g], &do_harmonic);
+      }
+    }
+  }
+}
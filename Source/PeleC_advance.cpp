@@ -97,12 +97,19 @@ PeleC::do_mol_advance(Real time,
   set_body_state(U_new);
 #endif
 
+  if (mol_rk_order > 2)
+  {
+    do_mol_ssprk_advance(time, dt, S);
+#ifdef PELE_USE_EB
+    set_body_state(U_new);
+#endif
+    return dt;
+  }
 
   // Compute S^{n} = MOLRhs(U^{n})
   if (verbose) { amrex::Print() << "... Computing MOL source term at t^{n} " << std::endl; }
-  FillPatch(*this, Sborder, nGrowTr, time, State_Type, 0, NUM_STATE);
   Real flux_factor = 0;
-  getMOLSrcTerm(Sborder, S, time, dt, flux_factor);
+  fillPatchAndGetMOLSrcTerm(time, S, time, dt, flux_factor);
 
   // Add in MMS source
 #ifdef USE_MASA
@@ -125,14 +132,14 @@ PeleC::do_mol_advance(Real time,
   }
 #endif
 
+  warmStartTemp(U_new);
   computeTemp(U_new,0);
 
 
   // Compute S^{n+1} = MOLRhs(U^{n+1,*})
   if (verbose) { amrex::Print() << "... Computing MOL source term at t^{n+1} " << std::endl; }
-  FillPatch(*this, Sborder, nGrowTr, time+dt, State_Type, 0, NUM_STATE);
   flux_factor = mol_iters > 1 ?  0 : 1;
-  getMOLSrcTerm(Sborder, S, time, dt, flux_factor);
+  fillPatchAndGetMOLSrcTerm(time+dt, S, time, dt, flux_factor);
 
   // Add in MMS source
 #ifdef USE_MASA
@@ -145,6 +152,7 @@ PeleC::do_mol_advance(Real time,
   // U^{n+1.**} = 0.5*(U^n + U^{n+1,*}) + 0.5*dt*S^{n+1} = U^n + 0.5*dt*S^n + 0.5*dt*S^{n+1} + 0.5*dt*I_R
   MultiFab::LinComb(U_new, 0.5, Sborder, 0, 0.5, U_old, 0, 0, NUM_STATE, 0);
   MultiFab::Saxpy(U_new, 0.5*dt, S, 0, 0, NUM_STATE, 0);   //  NOTE: If I_R=0, we are done and U_new is the final new-time state
+  warmStartTemp(U_new);
 
 #ifdef REACTIONS
   if (do_react == 1) {
@@ -161,7 +169,7 @@ PeleC::do_mol_advance(Real time,
   }
 #endif
 
-  computeTemp(U_new,0);
+  computeTempAfterReact(U_new,0);
 
 
 
@@ -171,9 +179,8 @@ PeleC::do_mol_advance(Real time,
     for (int mol_iter = 2; mol_iter<=mol_iters; ++mol_iter)
     {
       if (verbose) { amrex::Print() << "... Re-computing MOL source term at t^{n+1} (iter = " << mol_iter << " of " << mol_iters << ")" << std::endl; }
-      FillPatch(*this, Sborder, nGrowTr, time + dt, State_Type, 0, NUM_STATE);
       flux_factor = mol_iter==mol_iters  ?  1  : 0;
-      getMOLSrcTerm(Sborder, S_new, time, dt, flux_factor);
+      fillPatchAndGetMOLSrcTerm(time + dt, S_new, time, dt, flux_factor);
 
       // F_{AD} = (1/2)(S_old + S_new)
       MultiFab::LinComb(S, 0.5, S_old, 0, 0.5, S_new, 0, 0, NUM_STATE, 0);
@@ -181,7 +188,7 @@ PeleC::do_mol_advance(Real time,
       // Compute I_R and U^{n+1} = U^n + dt*(F_{AD} + I_R)
       react_state(time, dt, false, &S);  // false = not react_init
       
-      computeTemp(U_new,0);
+      computeTempAfterReact(U_new,0);
     }
   }
 #endif
@@ -193,6 +200,126 @@ PeleC::do_mol_advance(Real time,
   return dt;
 }
 
+void
+PeleC::do_mol_ssprk_advance(Real       time,
+                            Real       dt,
+                            MultiFab&  S)
+{
+/** Advance U_old to U_new with a low-storage SSP Runge-Kutta scheme,
+    selected by mol_rk_order:
+
+       3: three-stage, third-order Shu-Osher SSPRK(3,3), SSP coefficient 1
+       4: ten-stage, fourth-order SSPRK(10,4) of Ketcheson (2008), SSP coefficient 6
+
+    Stage values are kept in U_new (so that FillPatch at time+dt picks them
+    up), S holds the current stage rhs and SSPRK(10,4) needs one additional
+    register.  Reactions enter each stage through I_R as a constant source,
+    then react_state is called with the resulting advection-diffusion forcing,
+    as in the two-stage scheme.  Each stage rhs is added to the flux registers
+    with its weight in the final update, so that refluxing sees the
+    time-integrated flux of the scheme.
+
+       @param time the time at the start of the step
+       @param dt the timestep
+       @param S scratch for the stage rhs, on the valid region
+*/
+  BL_PROFILE("PeleC::do_mol_ssprk_advance()");
+
+  MultiFab& U_old = get_old_data(State_Type);
+  MultiFab& U_new = get_new_data(State_Type);
+
+#ifdef REACTIONS
+  MultiFab& I_R = get_new_data(Reactions_Type);
+#endif
+
+  // S = MOLRhs(U^{(k)}) + I_R, where U^{(k)} is the old state on the first
+  // stage and the stage value held in U_new on all later ones.  On return
+  // Sborder holds U^{(k)}.
+  int stage = 0;
+  auto stage_rhs = [&] (Real flux_factor) {
+    const Real fill_time = stage == 0 ? time : time + dt;
+    if (verbose) { amrex::Print() << "... Computing MOL source term, SSPRK stage " << stage+1 << std::endl; }
+    fillPatchAndGetMOLSrcTerm(fill_time, S, time, dt, flux_factor);
+
+#ifdef USE_MASA
+    if (do_mms == 1) {
+      fill_mms_source (time, Sborder, mms_source, 0);
+      MultiFab::Saxpy(S, 1.0, mms_source, 0, 0, NUM_STATE, 0);
+    }
+#endif
+
+#ifdef REACTIONS
+    if (do_react == 1) {
+      MultiFab::Add(S, I_R, 0,       FirstSpec, NumSpec, 0);
+      MultiFab::Add(S, I_R, NumSpec, Eden,      1,       0);
+    }
+#endif
+    ++stage;
+  };
+
+  if (mol_rk_order == 3)
+  {
+    // U^{(1)} = U^n + dt*S(U^n)
+    stage_rhs(1.0/6.0);
+    MultiFab::LinComb(U_new, 1.0, Sborder, 0, dt, S, 0, 0, NUM_STATE, 0);
+    warmStartTemp(U_new);
+    computeTemp(U_new,0);
+
+    // U^{(2)} = 3/4 U^n + 1/4 (U^{(1)} + dt*S(U^{(1)}))
+    stage_rhs(1.0/6.0);
+    MultiFab::LinComb(U_new, 0.75, U_old, 0, 0.25, Sborder, 0, 0, NUM_STATE, 0);
+    MultiFab::Saxpy(U_new, 0.25*dt, S, 0, 0, NUM_STATE, 0);
+    warmStartTemp(U_new);
+    computeTemp(U_new,0);
+
+    // U^{n+1} = 1/3 U^n + 2/3 (U^{(2)} + dt*S(U^{(2)}))
+    stage_rhs(2.0/3.0);
+    MultiFab::LinComb(U_new, 1.0/3.0, U_old, 0, 2.0/3.0, Sborder, 0, 0, NUM_STATE, 0);
+    MultiFab::Saxpy(U_new, (2.0/3.0)*dt, S, 0, 0, NUM_STATE, 0);
+    warmStartTemp(U_new);
+  }
+  else
+  {
+    // Ketcheson's low-storage form: q1 lives in U_new, q2 in U_2
+    MultiFab U_2(grids,dmap,NUM_STATE,0,MFInfo(),Factory());
+
+    for (int i = 1; i <= 9; ++i)
+    {
+      // q1 = q1 + dt/6 S(q1)
+      stage_rhs(0.1);
+      MultiFab::LinComb(U_new, 1.0, Sborder, 0, dt/6.0, S, 0, 0, NUM_STATE, 0);
+
+      if (i == 5) {
+        // q2 = 1/25 q2 + 9/25 q1, q1 = 15 q2 - 5 q1, with q2 = U^n up to here
+        MultiFab::LinComb(U_2, 1.0/25.0, U_old, 0, 9.0/25.0, U_new, 0, 0, NUM_STATE, 0);
+        MultiFab::LinComb(U_new, 15.0, U_2, 0, -5.0, U_new, 0, 0, NUM_STATE, 0);
+      }
+      warmStartTemp(U_new);
+      computeTemp(U_new,0);
+    }
+
+    // U^{n+1} = q2 + 3/5 q1 + dt/10 S(q1)
+    stage_rhs(0.1);
+    MultiFab::LinComb(U_new, 1.0, U_2, 0, 0.6, Sborder, 0, 0, NUM_STATE, 0);
+    MultiFab::Saxpy(U_new, 0.1*dt, S, 0, 0, NUM_STATE, 0);
+    warmStartTemp(U_new);
+  }
+
+#ifdef REACTIONS
+  if (do_react == 1) {
+    // F_{AD} = (1/dt)(U^{n+1,*} - U^n) - I_R
+    MultiFab::LinComb(S, 1.0/dt, U_new, 0, -1.0/dt, U_old, 0, 0, NUM_STATE, 0);
+    MultiFab::Subtract(S, I_R, 0,      FirstSpec, NumSpec, 0);
+    MultiFab::Subtract(S, I_R, NumSpec,Eden,      1,       0);
+
+    // Compute I_R and U^{n+1} = U^n + dt*(F_{AD} + I_R)
+    react_state(time, dt, false, &S);  // false = not react_init
+  }
+#endif
+
+  computeTempAfterReact(U_new,0);
+}
+
 #ifdef AMREX_PARTICLES
 void
 PeleC::set_spray_grid_info(int amr_iteration,
@@ -326,7 +453,7 @@ PeleC::do_sdc_iteration (Real time,
   else if (do_diffuse)
   {
     fill_Sborder = true;
-    nGrow_Sborder = NUM_GROW;
+    nGrow_Sborder = nGrowTr;
   }
 #ifdef AMREX_PARTICLES
   fill_Sborder = true;
@@ -469,7 +596,9 @@ PeleC::do_sdc_iteration (Real time,
     if (verbose) {
       amrex::Print() << "... Computing diffusion terms at t^(n+1," << sub_iteration+1 << ")" << std::endl;
     }
-    FillPatch(*this, Sborder, nGrowTr, time + dt, State_Type, 0, NUM_STATE);
+    // All of Sborder's ghost cells: getMOLSrcTerm computes the primitive
+    // state over them
+    FillPatch(*this, Sborder, Sborder.nGrow(), time + dt, State_Type, 0, NUM_STATE);
     Real flux_factor_new = sub_iteration==sub_ncycle-1 ? 0.5 : 0;
     getMOLSrcTerm(Sborder,*new_sources[diff_src],time,dt,flux_factor_new);
   }
@@ -534,7 +663,7 @@ PeleC::do_sdc_iteration (Real time,
 #endif
 
 
-  computeTemp(S_new, ng_src);
+  computeTempAfterReact(S_new, ng_src);
 
   finalize_sdc_iteration(time, dt, amr_iteration, amr_ncycle, sub_iteration, sub_ncycle);
 
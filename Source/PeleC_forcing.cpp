@@ -49,8 +49,7 @@ PeleC::fill_forcing_source (Real time, Real dt,
   const Real* prob_lo = geom.ProbLo();
 
 #ifdef PELE_USE_EB
-  auto const& fact = dynamic_cast<EBFArrayBoxFactory const&>(state_old.Factory());
-  auto const& flags = fact.getMultiEBCellFlagFab();
+  const EBTileIndex& eb_tiles = ebTileIndex(FabArrayBase::mfiter_tile_size, ng);
 #endif
 
 #ifdef _OPENMP
@@ -62,8 +61,7 @@ PeleC::fill_forcing_source (Real time, Real dt,
     RealBox gridloc = RealBox(grids[mfi.index()],geom.CellSize(),geom.ProbLo());
 
 #ifdef PELE_USE_EB
-    const auto& flag_fab = flags[mfi];
-    FabType typ = flag_fab.getType(bx);
+    FabType typ = eb_tiles.type(mfi);
     if (typ == FabType::covered) {
       continue;
     }
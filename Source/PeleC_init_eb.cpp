@@ -44,15 +44,74 @@ PeleC::init_eb (const Geometry& level_geom, const BoxArray& ba, const Distributi
 
 }
 
+const EBTileIndex&
+PeleC::ebTileIndex (const IntVect& tilesize, int ngrow, bool grow_tile) const
+{
+  for (const auto& ti : eb_tile_index) {
+    if (ti->matches(tilesize, ngrow, grow_tile)) return *ti;
+  }
+
+  BL_PROFILE("PeleC::ebTileIndex()");
+  const auto& ebfactory = dynamic_cast<EBFArrayBoxFactory const&>(Factory());
+  eb_tile_index.emplace_back(new EBTileIndex(ebfactory.getMultiEBCellFlagFab(),
+                                             tilesize, ngrow, grow_tile));
+  return *eb_tile_index.back();
+}
+
 #if BL_SPACEDIM > 1
 
+// Visit the cells of bx in the order of IntVect::operator<, which is the
+// order of the cut-cell and cut-face lists
+template <class F>
+static void
+for_each_lex (const Box& bx, F&& f)
+{
+  const IntVect& lo = bx.smallEnd();
+  const IntVect& hi = bx.bigEnd();
+  IntVect iv;
+  for (iv[0] = lo[0]; iv[0] <= hi[0]; ++iv[0]) {
+    for (iv[1] = lo[1]; iv[1] <= hi[1]; ++iv[1]) {
+#if BL_SPACEDIM > 2
+      for (iv[2] = lo[2]; iv[2] <= hi[2]; ++iv[2]) {
+#endif
+        f(iv);
+#if BL_SPACEDIM > 2
+      }
+#endif
+    }
+  }
+}
+
+static bool
+is_cut_cell (const EBCellFlagFab& flagfab, const Box& gbox, const IntVect& iv)
+{
+  if (!gbox.contains(iv)) return false;
+  const EBCellFlag& flag = flagfab(iv, 0);
+  return !(flag.isRegular() || flag.isCovered());
+}
+
+// Face iv (the low face of cell iv) in direction idir is partially covered
+// and borders a cut cell of gbox
+static bool
+is_cut_face (const EBCellFlagFab& flagfab, const CutFab& afrac_fab, const Box& gbox,
+             const IntVect& iv, int idir)
+{
+  return afrac_fab(iv) < 1.0 &&
+    (is_cut_cell(flagfab, gbox, iv) || is_cut_cell(flagfab, gbox, iv - BASISV(idir)));
+}
+
 /**
  * Set up PeleC EB Datastructures from AMReX EB2 constructs
  *
  * At the end of this routine, the following structures are populated:
  *   - FabArray ebmask
  *  - MultiFAB vfrac
- *  - sv_eb_bndry_geom
+ *  - sv_eb_bndry_geom, sv_eb_bndry_grad_stencil, flux_interp_stencil
+ *
+ * The boxes are counted, the packed arrays sized, and the boxes filled,
+ * each pass in parallel over the boxes.  Boxes that the level replaced by
+ * a regrid also had, on this rank, are copied from it since the geometry
+ * does not change.
  */
 
 void
@@ -87,24 +146,77 @@ PeleC::initialize_eb2_structs() {
 
   vfrac.copy(*volfrac);
 
-  // First pass over fabs to fill sparse per cut-cell ebg structures
-  sv_eb_bndry_geom.resize(vfrac.local_size());
-  sv_eb_bndry_grad_stencil.resize(vfrac.local_size());
-  sv_eb_flux.resize(vfrac.local_size());
-  sv_eb_bcval.resize(vfrac.local_size());
-
   auto const& flags = ebfactory.getMultiEBCellFlagFab();
 
+  const int nlocal = vfrac.local_size();
+
+  // The level this one replaces (regrid or rebalance), if any, is still
+  // held by Amr while this one is built; its local boxes that are also
+  // local boxes here keep their data
+  const PeleC* old = nullptr;
+  std::vector<int> reuse_local(nlocal, -1), reuse_global(nlocal, -1);
+  {
+    auto& levels = parent->getAmrLevels();
+    if (level < levels.size() && levels[level] != nullptr && levels[level].get() != this) {
+      old = static_cast<const PeleC*>(levels[level].get());
+
+      std::vector<Box> old_box;
+      std::vector<int> old_local, old_global;
+      for (MFIter mfi(old->vfrac, false); mfi.isValid(); ++mfi) {
+        old_box.push_back(mfi.validbox());
+        old_local.push_back(mfi.LocalIndex());
+        old_global.push_back(mfi.index());
+      }
+      for (MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+        for (int n = 0; n < old_box.size(); ++n) {
+          if (old_box[n] == mfi.validbox()) {
+            reuse_local[mfi.LocalIndex()] = old_local[n];
+            reuse_global[mfi.LocalIndex()] = old_global[n];
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // The cut faces in each direction are those of the cut cells of the fab
+  // box, for tiles grown by nGrowTr
+  Box fbox[BL_SPACEDIM];
+  for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+    fbox[idir] = amrex::bdryLo(Box(IntVect(D_DECL(0, 0, 0)),
+                                   IntVect(D_DECL(0, 0, 0))), idir, 1);
+
+    for (int idir1=0; idir1 < BL_SPACEDIM; ++idir1) {
+      if (idir1 != idir) fbox[idir].grow(idir1, 1);
+    }
+  }
+
+  // First pass: the ebmask, and the number of cut cells and cut faces of each fab
+  std::vector<int> ncut(nlocal, 0);
+  std::vector<int> nface[BL_SPACEDIM];
+  for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+    nface[idir].resize(nlocal, 0);
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
   for (MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
     BaseFab<int>& mfab = ebmask[mfi];
     const Box tbox = mfi.growntilebox();
-    const FArrayBox& vfab = vfrac[mfi];
     const EBCellFlagFab& flagfab = flags[mfi];
 
     FabType typ = flagfab.getType(tbox);
     int iLocal = mfi.LocalIndex();
 
-    if (typ == FabType::regular) {
+    if (reuse_local[iLocal] >= 0) {
+      const int iOld = reuse_local[iLocal];
+      mfab.copy(old->ebmask[reuse_global[iLocal]]);
+      ncut[iLocal] = old->sv_eb_bndry_geom.size(iOld);
+      for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+        nface[idir][iLocal] = old->flux_interp_stencil[idir].size(iOld);
+      }
+    } else if (typ == FabType::regular) {
       mfab.setVal(1);
     } else if (typ == FabType::covered) {
       mfab.setVal(-1);
@@ -112,122 +224,139 @@ PeleC::initialize_eb2_structs() {
       int Ncut = 0;
       for (BoxIterator bit(tbox); bit.ok(); ++bit) {
         const EBCellFlag& flag = flagfab(bit(), 0);
+        int m;
         if (!(flag.isRegular() || flag.isCovered())) {
           Ncut++;
+          m = 0;
+        } else if (flag.isRegular()) {
+          m = 1;
+        } else if (flag.isCovered()) {
+          m = -1;
+        } else {
+          m = 2;
         }
+        if (mfab.box().contains(bit())) mfab(bit()) = m;
       }
-
-      sv_eb_bndry_geom[iLocal].resize(Ncut);
-      int ivec = 0;
-      for (BoxIterator bit(tbox); bit.ok(); ++bit) {
-        const EBCellFlag& flag = flagfab(bit(), 0);
-        if (!(flag.isRegular() || flag.isCovered())) {
-          EBBndryGeom& sv_ebg = sv_eb_bndry_geom[iLocal][ivec];
-          ivec++;
-          sv_ebg.iv = bit();
-          if (mfab.box().contains(bit())) mfab(bit()) = 0;
-        } else {
-          if (flag.isRegular()) {
-            if (mfab.box().contains(bit())) mfab(bit()) = 1;
-          } else if (flag.isCovered()) {
-            if (mfab.box().contains(bit())) mfab(bit()) = -1;
-          } else {
-            if (mfab.box().contains(bit())) mfab(bit()) = 2;
-          }
+      ncut[iLocal] = Ncut;
+
+      const Box ftbox = mfi.growntilebox(nGrowTr);
+      FabType ftyp = flagfab.getType(ftbox);
+      if (ftyp == FabType::singlevalued) {
+        for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+          const CutFab& afrac_fab = (*eb2areafrac[idir])[mfi];
+          int Nsten = 0;
+          for_each_lex(Box(tbox).surroundingNodes(idir), [&](const IntVect& iv) {
+              if (is_cut_face(flagfab, afrac_fab, tbox, iv, idir)) Nsten++;
+            });
+          nface[idir][iLocal] = Nsten;
         }
+      } else if (ftyp != FabType::regular && ftyp != FabType::covered) {
+        amrex::Abort("multi-valued flux interp stencil to be implemented");
       }
-
-      int Nebg = sv_eb_bndry_geom[iLocal].size();
-
-      // Now call fortran to fill the ebg
-      pc_fill_sv_ebg(BL_TO_FORTRAN_BOX(tbox),
-                     sv_eb_bndry_geom[iLocal].data(), &Ncut,
-                     BL_TO_FORTRAN_ANYD((*volfrac)[mfi]),
-                     BL_TO_FORTRAN_ANYD((*bndrycent)[mfi]),
-                     D_DECL(BL_TO_FORTRAN_ANYD((*eb2areafrac[0])[mfi]),
-                            BL_TO_FORTRAN_ANYD((*eb2areafrac[1])[mfi]),
-                            BL_TO_FORTRAN_ANYD((*eb2areafrac[2])[mfi])));
-
-      sv_eb_bndry_grad_stencil[iLocal].resize(Ncut);
-
-      // Fill in boundary gradient for cut cells in this grown tile
-      const Real dx = geom.CellSize()[0];
-      auto& vec = sv_eb_bndry_geom[iLocal];
-      std::sort(vec.begin(), vec.end());
-      pc_fill_bndry_grad_stencil(BL_TO_FORTRAN_BOX(tbox),
-                                 sv_eb_bndry_geom[iLocal].data(), &Ncut,
-                                 sv_eb_bndry_grad_stencil[iLocal].data(),
-                                 &Ncut, &dx);
-
-      sv_eb_flux[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], NUM_STATE);
-      sv_eb_bcval[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], QVAR);
-
     } else {
       amrex::Print() << "unknown (or multivalued) fab type" << std::endl;
       amrex::Abort();
     }
   }
 
-  // Second pass over dirs and fabs to fill flux interpolation stencils
-  Box fbox[BL_SPACEDIM];
-
+  // Size the packed arrays from the counts
+  std::vector<int> nflux(nlocal), nbcval(nlocal);
+  for (int iLocal = 0; iLocal < nlocal; ++iLocal) {
+    nflux[iLocal]  = ncut[iLocal] * NUM_STATE;
+    nbcval[iLocal] = ncut[iLocal] * QVAR;
+  }
+  sv_eb_bndry_geom.define(ncut);
+  sv_eb_bndry_grad_stencil.define(ncut);
+  sv_eb_flux_data.define(nflux);
+  sv_eb_bcval_data.define(nbcval);
   for (int idir=0; idir < BL_SPACEDIM; ++idir) {
-    flux_interp_stencil[idir].resize(vfrac.local_size());
-
-
-    fbox[idir] = amrex::bdryLo(Box(IntVect(D_DECL(0, 0, 0)),
-                                   IntVect(D_DECL(0, 0, 0))), idir, 1);
+    flux_interp_stencil[idir].define(nface[idir]);
+  }
 
-    for (int idir1=0; idir1 < BL_SPACEDIM; ++idir1) {
-      if (idir1 != idir) fbox[idir].grow(idir1, 1);
+  // Second pass: fill the cut-cell geometry and the stencils of each fab
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+    const Box tbox = mfi.growntilebox();
+    const EBCellFlagFab& flagfab = flags[mfi];
+    int iLocal = mfi.LocalIndex();
+    int Ncut = ncut[iLocal];
+
+    if (reuse_local[iLocal] >= 0) {
+      const int iOld = reuse_local[iLocal];
+      std::copy(old->sv_eb_bndry_geom.data(iOld), old->sv_eb_bndry_geom.data(iOld) + Ncut,
+                sv_eb_bndry_geom.data(iLocal));
+      std::copy(old->sv_eb_bndry_grad_stencil.data(iOld), old->sv_eb_bndry_grad_stencil.data(iOld) + Ncut,
+                sv_eb_bndry_grad_stencil.data(iLocal));
+      for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+        const FaceSten* face_sten = old->flux_interp_stencil[idir].data(iOld);
+        std::copy(face_sten, face_sten + nface[idir][iLocal], flux_interp_stencil[idir].data(iLocal));
+      }
+      continue;
     }
 
-    for (MFIter  mfi(vfrac, false); mfi.isValid(); ++mfi) {
-      const Box tbox = mfi.growntilebox(nGrowTr);
-      const FArrayBox& vfab = vfrac[mfi];
-      const auto& flagfab = flags[mfi];
-      FabType typ = flagfab.getType(tbox);
-      int iLocal = mfi.LocalIndex();
-
-      if (typ == FabType::regular || typ == FabType::covered) {
-      } else if (typ == FabType::singlevalued) {
-        const Box ebox = Box(tbox).surroundingNodes(idir);
-        const CutFab&  afrac_fab = (*eb2areafrac[idir])[mfi];
-        const CutFab&  facecent_fab = (*facecent[idir])[mfi];
-
-        std::set<IntVect> cut_faces;
-
-        for (auto& sv_ebg : sv_eb_bndry_geom[iLocal]) {
-          const IntVect& iv = sv_ebg.iv;
-          for (int iside=0; iside <= 1; iside++) {
-            const IntVect iv_face = iv + iside*BASISV(idir);
-            if (afrac_fab(iv_face) < 1.0) {
-              cut_faces.insert(iv_face);
-            }
-          }
-        }
-
-        int Nsten = cut_faces.size();
-        if (Nsten > 0) {
-          flux_interp_stencil[idir][iLocal].resize(Nsten);
-          int ivec = 0;
-          for (std::set<IntVect>::const_iterator it = cut_faces.begin();
-                it != cut_faces.end(); ++it, ++ivec) {
-            flux_interp_stencil[idir][iLocal][ivec].iv = *it;
-          }
-
-          pc_fill_flux_interp_stencil(BL_TO_FORTRAN_BOX(tbox),
-                                      BL_TO_FORTRAN_BOX(fbox[idir]),
-                                      flux_interp_stencil[idir][iLocal].data(),
-                                      &Nsten, &idir,
-                                      BL_TO_FORTRAN_ANYD(facecent_fab),
-                                      BL_TO_FORTRAN_ANYD(afrac_fab));
-        }
-      } else {
-        amrex::Abort("multi-valued flux interp stencil to be implemented");
-      }
+    if (flagfab.getType(tbox) != FabType::singlevalued) continue;
+
+    // The cut cells, in sorted order
+    EBBndryGeom* ebg = sv_eb_bndry_geom.data(iLocal);
+    int ivec = 0;
+    for_each_lex(tbox, [&](const IntVect& iv) {
+        if (is_cut_cell(flagfab, tbox, iv)) ebg[ivec++].iv = iv;
+      });
+    BL_ASSERT(ivec == Ncut);
+
+    // Now call fortran to fill the ebg
+    pc_fill_sv_ebg(BL_TO_FORTRAN_BOX(tbox),
+                   ebg, &Ncut,
+                   BL_TO_FORTRAN_ANYD((*volfrac)[mfi]),
+                   BL_TO_FORTRAN_ANYD((*bndrycent)[mfi]),
+                   D_DECL(BL_TO_FORTRAN_ANYD((*eb2areafrac[0])[mfi]),
+                          BL_TO_FORTRAN_ANYD((*eb2areafrac[1])[mfi]),
+                          BL_TO_FORTRAN_ANYD((*eb2areafrac[2])[mfi])));
+
+    // Fill in boundary gradient for cut cells in this grown tile
+    const Real dx = geom.CellSize()[0];
+    pc_fill_bndry_grad_stencil(BL_TO_FORTRAN_BOX(tbox),
+                               ebg, &Ncut,
+                               sv_eb_bndry_grad_stencil.data(iLocal),
+                               &Ncut, &dx);
+
+    // Flux interpolation stencils of the cut faces, in sorted order
+    const Box ftbox = mfi.growntilebox(nGrowTr);
+    for (int idir=0; idir < BL_SPACEDIM; ++idir) {
+      int Nsten = nface[idir][iLocal];
+      if (Nsten == 0) continue;
+
+      const CutFab&  afrac_fab = (*eb2areafrac[idir])[mfi];
+      const CutFab&  facecent_fab = (*facecent[idir])[mfi];
+
+      FaceSten* face_sten = flux_interp_stencil[idir].data(iLocal);
+      int ivec = 0;
+      for_each_lex(Box(tbox).surroundingNodes(idir), [&](const IntVect& iv) {
+          if (is_cut_face(flagfab, afrac_fab, tbox, iv, idir)) face_sten[ivec++].iv = iv;
+        });
+      BL_ASSERT(ivec == Nsten);
+
+      pc_fill_flux_interp_stencil(BL_TO_FORTRAN_BOX(ftbox),
+                                  BL_TO_FORTRAN_BOX(fbox[idir]),
+                                  face_sten,
+                                  &Nsten, &idir,
+                                  BL_TO_FORTRAN_ANYD(facecent_fab),
+                                  BL_TO_FORTRAN_ANYD(afrac_fab));
     }
   }
+
+  // Views of the flux and boundary values of each box over its cut cells
+  sv_eb_flux.resize(nlocal);
+  sv_eb_bcval.resize(nlocal);
+  for (int iLocal = 0; iLocal < nlocal; ++iLocal) {
+    const int Ncut = sv_eb_bndry_grad_stencil.size(iLocal);
+    sv_eb_flux[iLocal].define(sv_eb_bndry_grad_stencil.data(iLocal), Ncut,
+                              sv_eb_flux_data.data(iLocal), NUM_STATE);
+    sv_eb_bcval[iLocal].define(sv_eb_bndry_grad_stencil.data(iLocal), Ncut,
+                               sv_eb_bcval_data.data(iLocal), QVAR);
+  }
 }
 
 void
@@ -300,11 +429,16 @@ PeleC::set_body_state(MultiFab& S)
   int nc = S.nComp();
   int covered_val = -1;
 
+  // Only the fabs with covered cells have cells to set
+  const EBTileIndex& eb_fabs = ebTileIndex(IntVect::TheZeroVector(), 0);
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-  for (MFIter mfi(S,true); mfi.isValid(); ++mfi)
+  for (MFIter mfi(S,false); mfi.isValid(); ++mfi)
   {
+    if (eb_fabs.type(mfi) == FabType::regular) continue;
+
     const Box& vbox = mfi.validbox();
     pc_set_body_state(vbox.loVect(), vbox.hiVect(),
                       BL_TO_FORTRAN_ANYD(S[mfi]),
@@ -324,11 +458,16 @@ PeleC::zero_in_body(MultiFab& S) const
   Vector<Real> zeros(nc,0);
   int covered_val = -1;
 
+  // Only the fabs with covered cells have cells to set
+  const EBTileIndex& eb_fabs = ebTileIndex(IntVect::TheZeroVector(), 0);
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-  for (MFIter mfi(S,true); mfi.isValid(); ++mfi)
+  for (MFIter mfi(S,false); mfi.isValid(); ++mfi)
   {
+    if (eb_fabs.type(mfi) == FabType::regular) continue;
+
     const Box& vbox = mfi.validbox();
     pc_set_body_state(vbox.loVect(), vbox.hiVect(),
                       BL_TO_FORTRAN_ANYD(S[mfi]),
@@ -4,6 +4,13 @@
 
 #include "AMReX_DistributionMapping.H"
 
+#include <numeric>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using std::string;
 using namespace amrex;
 
@@ -21,7 +28,11 @@ PeleC::react_state(Real time, Real dt, bool react_init, MultiFab* A_aux)
 
     if (verbose && ParallelDescriptor::IOProcessor()) {
         if (react_init) {
-            std::cout << "... Initializing reactions, using interval dt = " << dt << std::endl;
+            if (react_init_rates) {
+                std::cout << "... Initializing reactions from the production rates" << std::endl;
+            } else {
+                std::cout << "... Initializing reactions, using interval dt = " << dt << std::endl;
+            }
         }
         else {
             std::cout << "... Computing reactions for dt = " << dt << std::endl;
@@ -75,48 +86,197 @@ PeleC::react_state(Real time, Real dt, bool react_init, MultiFab* A_aux)
     MultiFab& reactions = get_new_data(Reactions_Type);
     reactions.setVal(0.0);
 
-    if (use_reactions_work_estimate) {
-	amrex::Abort("Need to implement redistribution of chemistry work");
-    }
+    long ncells = 0, nactive = 0;
 
+    // See keep_react_temp
+    const bool keep_temp = keep_react_temp() && !react_init;
+    long n_solve = 0, n_eval = 0, n_lin = 0, n_fail = 0;
+
+    // Cells integrated and seconds spent in each mechanism class of the
+    // batched integrator (0 = full mechanism)
+    Vector<Real> chem_stats(2 * (chem_reduced_nclass + 1), 0.0);
+
+    if (react_init && react_init_rates)
+    {
+      // Instantaneous production rates of the initial state, no integration
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+:ncells,nactive)
 #endif
+      for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
+      {
+        const Box& bx = mfi.growntilebox(ng);
+        const FArrayBox& u = S_new[mfi];
+        const IArrayBox& m = (*interior_mask)[mfi];
+        FArrayBox& I_R     = reactions[mfi];
+        int nmask = 0, nact = 0;
+        pc_react_rates(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                       u.dataPtr(),   ARLIM_3D(u.loVect()),   ARLIM_3D(u.hiVect()),
+                       m.dataPtr(),   ARLIM_3D(m.loVect()),   ARLIM_3D(m.hiVect()),
+                       I_R.dataPtr(), ARLIM_3D(I_R.loVect()), ARLIM_3D(I_R.hiVect()),
+                       nmask, nact);
+        ncells  += nmask;
+        nactive += nact;
+      }
+    }
+    else if (react_compact)
+    {
+      react_state_compact(time, dt, react_init, *Ap, *interior_mask, ncells, nactive, chem_stats);
+    }
+    else
     {
+      MultiFab* cache  = get_chem_cache();
+      const int ncache = (cache != nullptr) ? cache->nComp() : 0;
 
-        FArrayBox w;
-        for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
-        {
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:ncells,nactive,n_solve,n_eval,n_lin,n_fail)
+#endif
+      {
 
-          const Box& bx = mfi.growntilebox(ng);
-
-          const FArrayBox& uold = react_init ? S_new[mfi] : get_old_data(State_Type)[mfi];
-          FArrayBox& unew       = S_new[mfi];
-          FArrayBox& a          = (*Ap)[mfi];
-          const IArrayBox& m    = (*interior_mask)[mfi];
-          w.resize(bx,1);
-          FArrayBox& I_R        = reactions[mfi];
-          int do_update         = react_init ? 0 : 1;  // TODO: Update here? Or just get reaction source?
-
-          pc_react_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
-                         uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
-                         unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
-                         a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
-                         m.dataPtr(),     ARLIM_3D(m.loVect()),     ARLIM_3D(m.hiVect()),
-                         w.dataPtr(),     ARLIM_3D(w.loVect()),     ARLIM_3D(w.hiVect()),
-                         I_R.dataPtr(),   ARLIM_3D(I_R.loVect()),   ARLIM_3D(I_R.hiVect()),
-                         time, dt, do_update);
-
-          if (do_react_load_balance || do_mol_load_balance)
+          FArrayBox w;
+          IArrayBox act;
+          Vector<Real> tstats(chem_stats.size(), 0.0);
+          for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
           {
-            get_new_data(Work_Estimate_Type)[mfi].plus(w);
+
+            const Box& bx = mfi.growntilebox(ng);
+
+            const FArrayBox& uold = react_init ? S_new[mfi] : get_old_data(State_Type)[mfi];
+            FArrayBox& unew       = S_new[mfi];
+            FArrayBox& a          = (*Ap)[mfi];
+            const IArrayBox& m    = (*interior_mask)[mfi];
+            w.resize(bx,1);
+            w.setVal(0);
+            FArrayBox& I_R        = reactions[mfi];
+            int do_update         = react_init ? 0 : 1;  // TODO: Update here? Or just get reaction source?
+
+            Real wt = ParallelDescriptor::second();
+
+            // Only integrate the cells where the chemistry is active
+            act.resize(bx,1);
+            int nmask = 0, nact = 0;
+            pc_react_activity(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                              uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                              unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                              m.dataPtr(),     ARLIM_3D(m.loVect()),     ARLIM_3D(m.hiVect()),
+                              act.dataPtr(),   ARLIM_3D(act.loVect()),   ARLIM_3D(act.hiVect()),
+                              dt, react_activity_tol, nmask, nact);
+            ncells  += nmask;
+            nactive += nact;
+
+            if (chem_integrator == 1)
+            {
+              // w stands in for the cache when there is none (ncache = 0)
+              FArrayBox& ch = (cache != nullptr) ? (*cache)[mfi] : w;
+              pc_react_state_batch(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                   uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                                   unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                                   a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
+                                   act.dataPtr(),   ARLIM_3D(act.loVect()),   ARLIM_3D(act.hiVect()),
+                                   w.dataPtr(),     ARLIM_3D(w.loVect()),     ARLIM_3D(w.hiVect()),
+                                   I_R.dataPtr(),   ARLIM_3D(I_R.loVect()),   ARLIM_3D(I_R.hiVect()),
+                                   ch.dataPtr(),    ARLIM_3D(ch.loVect()),    ARLIM_3D(ch.hiVect()), ncache,
+                                   tstats.dataPtr(),
+                                   time, dt, do_update, chem_batch_size);
+            }
+            else
+            {
+              pc_react_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                             uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                             unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                             a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
+                             act.dataPtr(),   ARLIM_3D(act.loVect()),   ARLIM_3D(act.hiVect()),
+                             w.dataPtr(),     ARLIM_3D(w.loVect()),     ARLIM_3D(w.hiVect()),
+                             I_R.dataPtr(),   ARLIM_3D(I_R.loVect()),   ARLIM_3D(I_R.hiVect()),
+                             time, dt, do_update);
+            }
+
+            // T of the cells left to the non-reacting update, see keep_react_temp
+            if (keep_temp)
+            {
+              const Box& vbox = mfi.tilebox();
+              int stats[4] = {0, 0, 0, 0};
+              reset_internal_e(ARLIM_3D(vbox.loVect()), ARLIM_3D(vbox.hiVect()),
+                               BL_TO_FORTRAN_3D(unew), print_fortran_warnings);
+              compute_temp_masked(ARLIM_3D(vbox.loVect()), ARLIM_3D(vbox.hiVect()),
+                                  BL_TO_FORTRAN_3D(unew), BL_TO_FORTRAN_3D(act),
+                                  &temp_newton_tol, &temp_lin_tol, stats);
+              n_solve += stats[0];
+              n_eval  += stats[1];
+              n_lin   += stats[2];
+              n_fail  += stats[3];
+            }
+
+            // The chemistry cost returned per cell (integrator work) is used
+            // to spread the measured time of the tile over its cells, so that
+            // the estimate is in the same units as the MOL timings
+            if (do_react_load_balance)
+            {
+              wt = ParallelDescriptor::second() - wt;
+              const Box& vbox = mfi.tilebox();
+              const Real wsum = w.sum(bx,0);
+              if (wsum > 0) {
+                w.mult(wt / wsum, bx);
+              } else {
+                w.setVal(wt / bx.d_numPts(), bx);
+              }
+              get_new_data(Work_Estimate_Type)[mfi].plus(w, vbox, 0, 0, 1);
+            }
           }
-        }
+#ifdef _OPENMP
+#pragma omp critical (react_state_stats)
+#endif
+          for (int i = 0; i < chem_stats.size(); ++i) {
+            chem_stats[i] += tstats[i];
+          }
+      }
+
+      temp_stats[0] += n_solve;
+      temp_stats[1] += n_eval;
+      temp_stats[2] += n_lin;
+      temp_stats[3] += n_fail;
     }
 
     if (ng > 0)
         S_new.FillBoundary(geom.periodicity());
 
+    if (verbose) {
+        long counts[2] = {ncells, nactive};
+        ParallelDescriptor::ReduceLongSum(counts, 2, ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "[Level " << level << "] reacting cells: " << counts[1] << " of " << counts[0]
+                       << " (active fraction " << (counts[0] > 0 ? Real(counts[1]) / counts[0] : 0.0) << ")\n";
+        if (react_substep && !react_init) {
+            const Real nsub_max = reactions.max(NumSpec+1);
+            const Real nsub_sum = reactions.sum(NumSpec+1);
+            amrex::Print() << "[Level " << level << "] chemistry substeps: mean "
+                           << (counts[1] > 0 ? nsub_sum / counts[1] : 0.0)
+                           << " per reacting cell, max " << nsub_max << "\n";
+        }
+    }
+
+    // Per-class integration cost; the speedup estimate prices every cell
+    // at the measured cost per cell of the full mechanism
+    if (verbose && chem_integrator == 1 && chem_reduced_nclass > 0)
+    {
+        ParallelDescriptor::ReduceRealSum(chem_stats.dataPtr(), chem_stats.size(),
+                                          ParallelDescriptor::IOProcessorNumber());
+        Real ntot = 0.0, ttot = 0.0;
+        amrex::Print() << "[Level " << level << "] chemistry classes:";
+        for (int c = 0; c <= chem_reduced_nclass; ++c)
+        {
+            const Real n = chem_stats[2*c], t = chem_stats[2*c+1];
+            ntot += n;
+            ttot += t;
+            amrex::Print() << " " << c << ": " << long(n) << " cells, "
+                           << (n > 0 ? t / n : 0.0) << " s/cell;";
+        }
+        if (chem_stats[0] > 0 && ttot > 0) {
+            amrex::Print() << " estimated speedup over the full mechanism "
+                           << ntot * (chem_stats[1] / chem_stats[0]) / ttot << "\n";
+        } else {
+            amrex::Print() << " no full-mechanism cells to estimate the speedup from\n";
+        }
+    }
+
     if (verbose > 1) {
 
         const int IOProc   = ParallelDescriptor::IOProcessorNumber();
@@ -126,12 +286,337 @@ PeleC::react_state(Real time, Real dt, bool react_init, MultiFab* A_aux)
 	Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+        ParallelDescriptor::ReduceLongSum(nactive, IOProc);
 
+	// Rate of this run's integrator over the whole of react_state; see
+	// chem_rate_sample for both integrators on the same cells
 	if (ParallelDescriptor::IOProcessor())
-	  std::cout << "PeleC::react_state() time = " << run_time << "\n";
+	  std::cout << "PeleC::react_state() time = " << run_time
+                    << ", reacting cells/s = " << nactive / run_time
+                    << " (chem_integrator = " << chem_integrator << ")\n";
 #ifdef BL_LAZY
 	});
 #endif
 
     }
 }
+
+// Chemistry on a compacted list of cells.  The active cells of all local
+// tiles are packed into one flat buffer, integrated in chunks of
+// react_chunk_size cells that the threads pick up dynamically, and then
+// scattered back into the state and the reaction source.  The wall time
+// thus follows the number of active cells rather than the costliest tile.
+void
+PeleC::react_state_compact(Real time, Real dt, bool react_init,
+                           const MultiFab& A, const iMultiFab& interior_mask,
+                           long& ncells, long& nactive, Vector<Real>& chem_stats)
+{
+    BL_PROFILE("PeleC::react_state_compact()");
+
+    MultiFab& S_new = get_new_data(State_Type);
+    const MultiFab& S_old = react_init ? S_new : get_old_data(State_Type);
+    MultiFab& reactions = get_new_data(Reactions_Type);
+
+    const int ng        = S_new.nGrow();
+    const int do_update = react_init ? 0 : 1;
+    const bool keep_temp = keep_react_temp() && !react_init;
+
+    MultiFab* cache  = get_chem_cache();
+    const int ncache = (cache != nullptr) ? cache->nComp() : 0;
+
+    // A cell is packed as (rho Y, T), rho Y source, e, rho e source, cost,
+    // number of substeps and its ncache warm-start values
+    const int icost = 2*NumSpec + 3;
+    const int nbuf  = 2*NumSpec + 5 + ncache;
+
+    // The local tiles, in a fixed order so that the gather and the
+    // scatter agree on the position of each cell in the buffer
+    Vector<int> tile_fab;
+    Vector<Box> tile_box;
+    for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
+    {
+      tile_fab.push_back(mfi.index());
+      tile_box.push_back(mfi.growntilebox(ng));
+    }
+    const int ntiles = tile_fab.size();
+
+    iMultiFab act(grids, dmap, 1, ng);
+    Vector<long> offset(ntiles+1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:ncells,nactive)
+#endif
+    for (int t = 0; t < ntiles; ++t)
+    {
+      const Box& bx         = tile_box[t];
+      const FArrayBox& uold = S_old[tile_fab[t]];
+      const FArrayBox& unew = S_new[tile_fab[t]];
+      const IArrayBox& m    = interior_mask[tile_fab[t]];
+      IArrayBox& a          = act[tile_fab[t]];
+
+      int nmask = 0, nact = 0;
+      pc_react_activity(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                        uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                        unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                        m.dataPtr(),     ARLIM_3D(m.loVect()),     ARLIM_3D(m.hiVect()),
+                        a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
+                        dt, react_activity_tol, nmask, nact);
+      ncells      += nmask;
+      nactive     += nact;
+      offset[t+1]  = nact;
+    }
+
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+    const long ncomp_cells = offset[ntiles];
+
+    Vector<Real> buf(ncomp_cells * nbuf);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int t = 0; t < ntiles; ++t)
+    {
+      if (offset[t+1] == offset[t]) continue;
+
+      const Box& bx         = tile_box[t];
+      const FArrayBox& uold = S_old[tile_fab[t]];
+      const FArrayBox& unew = S_new[tile_fab[t]];
+      const FArrayBox& a    = A[tile_fab[t]];
+      const IArrayBox& m    = act[tile_fab[t]];
+      const FArrayBox& ch   = (cache != nullptr) ? (*cache)[tile_fab[t]] : a;  // a if ncache = 0
+
+      pc_react_gather(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                      uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                      unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                      a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
+                      m.dataPtr(),     ARLIM_3D(m.loVect()),     ARLIM_3D(m.hiVect()),
+                      ch.dataPtr(),    ARLIM_3D(ch.loVect()),    ARLIM_3D(ch.hiVect()), ncache,
+                      buf.dataPtr() + offset[t] * nbuf, nbuf, dt);
+    }
+
+    // Both integrators on the same sample of the local cells
+    // (chem_rate_sample), each on its own copy of them
+    if (verbose > 1 && chem_rate_sample > 0)
+    {
+      const int nsample = std::min(long(chem_rate_sample), ncomp_cells);
+      Vector<Real> sample_stats(chem_stats.size(), 0.0);
+      Real sample[3] = {Real(nsample), 0.0, 0.0};
+
+      for (int integrator = 0; integrator <= 1; ++integrator)
+      {
+        Vector<Real> b(buf.begin(), buf.begin() + nsample * nbuf);
+        const Real wt = ParallelDescriptor::second();
+        if (nsample > 0) {
+          pc_react_cells(nsample, b.dataPtr(), nbuf, time, dt, integrator, chem_batch_size,
+                         sample_stats.dataPtr());
+        }
+        sample[1+integrator] = ParallelDescriptor::second() - wt;
+      }
+
+      ParallelDescriptor::ReduceRealSum(sample, 3, ParallelDescriptor::IOProcessorNumber());
+      amrex::Print() << "[Level " << level << "] sampled chemistry rate on " << long(sample[0])
+                     << " cells: reactor " << (sample[1] > 0 ? sample[0] / sample[1] : 0.0)
+                     << " cells/s, batched BDF " << (sample[2] > 0 ? sample[0] / sample[2] : 0.0)
+                     << " cells/s\n";
+    }
+
+    // Integrate the flat list.  When load balancing on the chemistry, the
+    // measured time of a chunk is spread over its cells by their
+    // integrator cost, so that the estimate is in seconds.
+#ifdef _OPENMP
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+    Vector<Real> busy(nthreads, 0.0);
+    Vector<Vector<Real>> tstats(nthreads, Vector<Real>(chem_stats.size(), 0.0));
+
+    const long chunk   = std::max(react_chunk_size, 1);
+    const long nchunks = (ncomp_cells + chunk - 1) / chunk;
+    const Real wall0   = ParallelDescriptor::second();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for (long ic = 0; ic < nchunks; ++ic)
+    {
+#ifdef _OPENMP
+      const int tid = omp_get_thread_num();
+#else
+      const int tid = 0;
+#endif
+      const long c0 = ic * chunk;
+      const int  n  = std::min(chunk, ncomp_cells - c0);
+      Real* b       = buf.dataPtr() + c0 * nbuf;
+
+      const Real wt = ParallelDescriptor::second();
+      pc_react_cells(n, b, nbuf, time, dt, chem_integrator, chem_batch_size, tstats[tid].dataPtr());
+      const Real dwt = ParallelDescriptor::second() - wt;
+      busy[tid] += dwt;
+
+      if (do_react_load_balance)
+      {
+        Real csum = 0.0;
+        for (int c = 0; c < n; ++c) {
+          csum += b[c*nbuf + icost];
+        }
+        for (int c = 0; c < n; ++c) {
+          Real& cost = b[c*nbuf + icost];
+          cost = (csum > 0) ? dwt * cost / csum : dwt / n;
+        }
+      }
+    }
+
+    const Real wall = ParallelDescriptor::second() - wall0;
+
+    for (const auto& ts : tstats) {
+      for (int i = 0; i < chem_stats.size(); ++i) {
+        chem_stats[i] += ts[i];
+      }
+    }
+
+    long n_solve = 0, n_eval = 0, n_lin = 0, n_fail = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:n_solve,n_eval,n_lin,n_fail)
+#endif
+    for (int t = 0; t < ntiles; ++t)
+    {
+      const Box& bx         = tile_box[t];
+      FArrayBox& unew       = S_new[tile_fab[t]];
+      const IArrayBox& m    = act[tile_fab[t]];
+
+      // T of the cells left to the non-reacting update (see keep_react_temp);
+      // the scatter below only writes the integrated cells
+      if (keep_temp)
+      {
+        const Box vbox = bx & grids[tile_fab[t]];
+        int stats[4] = {0, 0, 0, 0};
+        reset_internal_e(ARLIM_3D(vbox.loVect()), ARLIM_3D(vbox.hiVect()),
+                         BL_TO_FORTRAN_3D(unew), print_fortran_warnings);
+        compute_temp_masked(ARLIM_3D(vbox.loVect()), ARLIM_3D(vbox.hiVect()),
+                            BL_TO_FORTRAN_3D(unew), BL_TO_FORTRAN_3D(m),
+                            &temp_newton_tol, &temp_lin_tol, stats);
+        n_solve += stats[0];
+        n_eval  += stats[1];
+        n_lin   += stats[2];
+        n_fail  += stats[3];
+      }
+
+      if (offset[t+1] == offset[t]) continue;
+
+      const FArrayBox& uold = S_old[tile_fab[t]];
+      const FArrayBox& a    = A[tile_fab[t]];
+      FArrayBox& I_R        = reactions[tile_fab[t]];
+
+      FArrayBox w(bx,1);
+      w.setVal(0);
+      FArrayBox& ch = (cache != nullptr) ? (*cache)[tile_fab[t]] : w;  // w if ncache = 0
+
+      pc_react_scatter(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                       uold.dataPtr(),  ARLIM_3D(uold.loVect()),  ARLIM_3D(uold.hiVect()),
+                       unew.dataPtr(),  ARLIM_3D(unew.loVect()),  ARLIM_3D(unew.hiVect()),
+                       a.dataPtr(),     ARLIM_3D(a.loVect()),     ARLIM_3D(a.hiVect()),
+                       m.dataPtr(),     ARLIM_3D(m.loVect()),     ARLIM_3D(m.hiVect()),
+                       w.dataPtr(),     ARLIM_3D(w.loVect()),     ARLIM_3D(w.hiVect()),
+                       I_R.dataPtr(),   ARLIM_3D(I_R.loVect()),   ARLIM_3D(I_R.hiVect()),
+                       ch.dataPtr(),    ARLIM_3D(ch.loVect()),    ARLIM_3D(ch.hiVect()), ncache,
+                       buf.dataPtr() + offset[t] * nbuf, nbuf, dt, do_update);
+
+      if (do_react_load_balance)
+      {
+        const Box vbox = bx & grids[tile_fab[t]];
+        get_new_data(Work_Estimate_Type)[tile_fab[t]].plus(w, vbox, 0, 0, 1);
+      }
+    }
+
+    temp_stats[0] += n_solve;
+    temp_stats[1] += n_eval;
+    temp_stats[2] += n_lin;
+    temp_stats[3] += n_fail;
+
+    // Thread utilization of the integration: busy time summed over the
+    // threads relative to threads x wall time (min over ranks), and the
+    // busiest thread relative to the mean (max over ranks)
+    if (verbose > 1)
+    {
+      Real busy_sum = 0.0, busy_max = 0.0;
+      for (int i = 0; i < nthreads; ++i) {
+        busy_sum += busy[i];
+        busy_max  = std::max(busy_max, busy[i]);
+      }
+      Real util      = (wall > 0) ? busy_sum / (nthreads * wall) : 1.0;
+      Real imbalance = (busy_sum > 0) ? busy_max * nthreads / busy_sum : 1.0;
+
+      const int IOProc = ParallelDescriptor::IOProcessorNumber();
+      ParallelDescriptor::ReduceRealMin(util, IOProc);
+      ParallelDescriptor::ReduceRealMax(imbalance, IOProc);
+
+      amrex::Print() << "[Level " << level << "] react_state compacted: " << nchunks << " chunks on "
+                     << nthreads << " threads, thread utilization " << util
+                     << ", busiest thread / mean " << imbalance << "\n";
+    }
+}
+
+MultiFab*
+PeleC::get_chem_cache ()
+{
+    if (!chem_jac_reuse || chem_integrator != 1) return nullptr;
+
+    MultiFab& S_new = get_new_data(State_Type);
+
+    // Data built for other grids is of no use
+    if (chem_cache && (chem_cache->boxArray() != grids || chem_cache->DistributionMap() != dmap)) {
+      free_chem_cache();
+    }
+
+    if (chem_cache_ncomp < 0)
+    {
+      int nfull;
+      pc_batch_bdf_cache_size(&nfull);
+
+      long npts = 0;
+      for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+        npts += mfi.fabbox().numPts();
+      }
+
+      // Full data (step and Jacobian) if it fits, else the steps alone
+      const long budget = static_cast<long>(chem_cache_mb * 1024.0 * 1024.0);
+      chem_cache_ncomp = 0;
+      if (chem_cache_bytes + npts * nfull * sizeof(Real) <= budget) {
+        chem_cache_ncomp = nfull;
+      } else if (chem_cache_bytes + npts * sizeof(Real) <= budget) {
+        chem_cache_ncomp = 1;
+      }
+
+      // Every rank must agree on the layout
+      ParallelDescriptor::ReduceIntMin(chem_cache_ncomp);
+
+      if (chem_cache_ncomp < nfull && ParallelDescriptor::IOProcessor()) {
+        std::ostringstream msg;
+        msg << "chem_jac_reuse: level " << level << " keeps "
+            << (chem_cache_ncomp > 0 ? "step sizes only" : "no warm-start data")
+            << " within chem_cache_mb = " << chem_cache_mb;
+        amrex::Warning(msg.str().c_str());
+      }
+
+      if (chem_cache_ncomp > 0)
+      {
+        chem_cache.reset(new MultiFab(grids, dmap, chem_cache_ncomp, S_new.nGrow()));
+        chem_cache->setVal(0.0);
+        chem_cache_nbytes = npts * chem_cache_ncomp * sizeof(Real);
+        chem_cache_bytes += chem_cache_nbytes;
+      }
+    }
+
+    return chem_cache.get();
+}
+
+void
+PeleC::free_chem_cache ()
+{
+    chem_cache.reset();
+    chem_cache_bytes -= chem_cache_nbytes;
+    chem_cache_nbytes = 0;
+    chem_cache_ncomp  = -1;
+}
@@ -4,6 +4,7 @@
 #include <AMReX_ParmParse.H>
 #include "PeleC.H"
 #include "PeleC_F.H"
+#include <MOLHypFlux.H>
 #include <Derive_F.H>
 #include "AMReX_buildInfo.H"
 
@@ -174,6 +175,9 @@ PeleC::variableSetUp ()
     // Initialize the network
     init_network();
 
+    // Select the row EOS evaluation (eos_vec_module)
+    pc_eos_vec_init(&eos_row_newton);
+
 #ifdef REACTIONS
     // Initialize the reactor
     if (do_react == 1) {
@@ -225,6 +229,13 @@ PeleC::variableSetUp ()
 	cnt += NumSpec;
     }
 
+    if (mol_flux_kernel == 1 && !MOLHypFlux::supported(NumSpec))
+    {
+        amrex::Print() << "Warning: no specialized MOL flux kernel for " << NumSpec
+                       << " species in " << BL_SPACEDIM << "D; using the Fortran kernel\n";
+        mol_flux_kernel = 0;
+    }
+
     // Get the number of auxiliary quantities from the network model.
     get_num_aux(&NumAux);
   
@@ -272,6 +283,10 @@ PeleC::variableSetUp ()
               pstate_loc, pstate_vel, pstate_T, pstate_dia, pstate_rho, pstate_spc,
               pfld_vel, pfld_rho, pfld_T, pfld_p, pfld_spc);
 
+    // Tell the diffusion operator which flux groups to build
+    const int diffuse_ener = (diffuse_temp || diffuse_enth) ? 1 : 0;
+    set_diffusion_groups(diffuse_vel, diffuse_ener, diffuse_spec);
+
     // Get various values from Fortran
     get_method_params(&NUM_GROW,&QTHERM,&QVAR,&cQRHO,&cQU,&cQV,&cQW,&cQGAME,&cQPRES,
                       &cQREINT,&cQTEMP,&cQFA,&cQFS,&cQFX,&NQAUX,&cQGAMC,&cQC,&cQCSML,
@@ -360,17 +375,21 @@ PeleC::variableSetUp ()
 
     // Components 0:Numspec-1         are      rho.omega_i
     // Component    NumSpec            is      rho.edot = (rho.eout-rho.ein)
+    // Component    NumSpec+1          is      the number of chemistry substeps (react_substep)
 #ifdef REACTIONS
+    const int NumReact = NumSpec + 1 + (react_substep ? 1 : 0);
     store_in_checkpoint = true;
     desc_lst.addDescriptor(Reactions_Type,IndexType::TheCellType(),
-			   StateDescriptor::Point,0,NumSpec+1,
+			   StateDescriptor::Point,0,NumReact,
 			   &cell_cons_interp,state_data_extrap,store_in_checkpoint);
 #endif
 
     Vector<BCRec>       bcs(NUM_STATE);
     Vector<std::string> name(NUM_STATE);
-    Vector<BCRec>       react_bcs(NumSpec+1);
-    Vector<std::string> react_name(NumSpec+1);
+#ifdef REACTIONS
+    Vector<BCRec>       react_bcs(NumReact);
+    Vector<std::string> react_name(NumReact);
+#endif
 
     BCRec bc;
     cnt = 0;
@@ -410,6 +429,12 @@ PeleC::variableSetUp ()
 	std::cout << std::endl;
     } 
 
+#ifdef REACTIONS
+    if (do_react == 1) {
+	init_reduced_chemistry();
+    }
+#endif
+
     for (int i=0; i<NumSpec; ++i)
     {
 	cnt++; 
@@ -463,6 +488,10 @@ PeleC::variableSetUp ()
    set_react_src_bc(bc, phys_bc);
    react_bcs[NumSpec] = bc;
    react_name[NumSpec] = "rhoe_dot";
+   if (react_substep) {
+     react_bcs[NumSpec+1] = bc;
+     react_name[NumSpec+1] = "chem_substeps";
+   }
 
    desc_lst.setComponent(Reactions_Type,
                          0,
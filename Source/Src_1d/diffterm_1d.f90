@@ -25,7 +25,8 @@ contains
                          deltax) bind(C, name = "pc_diffterm")
 
     use actual_network, only     : nspec
-    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QPRES, QTEMP, QFS, QRHO
+    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QPRES, QTEMP, QFS, QRHO, &
+                                   do_diff_vel, do_diff_ener, do_diff_spec
     use amrex_constants_module
     use eos_type_module
     use eos_module
@@ -76,60 +77,72 @@ contains
 
     gfaci = dxinv(1)
  
-    do i=lo(1),hi(1)+1
-       dTdx = gfaci(i) * (Q(i,QTEMP) - Q(i-1,QTEMP))
-       dudx = gfaci(i) * (Q(i,QU)    - Q(i-1,QU))
-
-       divu = dudx
-       tauxx = mux(i)*(2.d0*dudx-twoThirds*divu) + xix(i)*divu
-       Uface    = HALF*(Q(i,QU) + Q(i-1,QU))
-       pface    = HALF*(Q(i,QPRES) + Q(i-1,QPRES))
-
-       fx(i,UMX)   = - tauxx
-       fx(i,UMY)   = 0.d0
-       fx(i,UMZ)   = 0.d0
-       fx(i,UEDEN) = - tauxx*Uface - lamx(i)*dTdx
-
-       dlnpi(i) = gfaci(i) * (Q(i,QPRES) - Q(i-1,QPRES)) / pface
-    end do
+    if (do_diff_vel) then
+       do i=lo(1),hi(1)+1
+          dudx = gfaci(i) * (Q(i,QU)    - Q(i-1,QU))
+
+          divu = dudx
+          tauxx = mux(i)*(2.d0*dudx-twoThirds*divu) + xix(i)*divu
+          Uface    = HALF*(Q(i,QU) + Q(i-1,QU))
+
+          fx(i,UMX)   = - tauxx
+          fx(i,UMY)   = 0.d0
+          fx(i,UMZ)   = 0.d0
+          fx(i,UEDEN) = - tauxx*Uface
+       end do
+    end if
 
-    do i=lo(1)-1,hi(1)+1
-       eosi(i) % massfrac(:) = Q(i,QFS:QFS+nspec-1)
-       eosi(i) % T           = Q(i,QTEMP)
-       eosi(i) % rho         = Q(i,QRHO)
-       eosi(i) % p           = Q(i,QPRES)
-       call eos_ytx(eosi(i))
-       call eos_hi(eosi(i))
-    end do
+    if (do_diff_ener) then
+       do i=lo(1),hi(1)+1
+          dTdx = gfaci(i) * (Q(i,QTEMP) - Q(i-1,QTEMP))
+          fx(i,UEDEN) = fx(i,UEDEN) - lamx(i)*dTdx
+       end do
+    end if
 
-    ! Get species/enthalpy diffusion, compute correction velocity
-    Vci = 0.d0
-    do n=1,nspec
-       do i = lo(1), hi(1)+1
-          Xface = HALF*(eosi(i)%molefrac(n) + eosi(i-1)%molefrac(n))
-          Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
-          hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
+    if (do_diff_spec) then
+       do i=lo(1),hi(1)+1
+          pface    = HALF*(Q(i,QPRES) + Q(i-1,QPRES))
+          dlnpi(i) = gfaci(i) * (Q(i,QPRES) - Q(i-1,QPRES)) / pface
+       end do
 
-          dXdx = gfaci(i) * (eosi(i)%molefrac(n) - eosi(i-1)%molefrac(n))
-          Vd = -Dx(i,n)*(dXdx + (Xface - Yface) * dlnpi(i))
+       do i=lo(1)-1,hi(1)+1
+          eosi(i) % massfrac(:) = Q(i,QFS:QFS+nspec-1)
+          eosi(i) % T           = Q(i,QTEMP)
+          eosi(i) % rho         = Q(i,QRHO)
+          eosi(i) % p           = Q(i,QPRES)
+          call eos_ytx(eosi(i))
+          call eos_hi(eosi(i))
+       end do
 
-          fx(i,UFS+n-1) = Vd
-          Vci(i) = Vci(i) + Vd
-          fx(i,UEDEN) = fx(i,UEDEN) + Vd*hface
+       ! Get species/enthalpy diffusion, compute correction velocity
+       Vci = 0.d0
+       do n=1,nspec
+          do i = lo(1), hi(1)+1
+             Xface = HALF*(eosi(i)%molefrac(n) + eosi(i-1)%molefrac(n))
+             Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
+             hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
+
+             dXdx = gfaci(i) * (eosi(i)%molefrac(n) - eosi(i-1)%molefrac(n))
+             Vd = -Dx(i,n)*(dXdx + (Xface - Yface) * dlnpi(i))
+
+             fx(i,UFS+n-1) = Vd
+             Vci(i) = Vci(i) + Vd
+             fx(i,UEDEN) = fx(i,UEDEN) + Vd*hface
+          end do
        end do
-    end do
 
-    ! Add correction velocity
-    do n=1,nspec
-       do i = lo(1), hi(1)+1
-          Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
-          hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
+       ! Add correction velocity
+       do n=1,nspec
+          do i = lo(1), hi(1)+1
+             Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
+             hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
 
-          fx(i,UFS+n-1) = fx(i,UFS+n-1) - Yface*Vci(i)
-          fx(i,UEDEN)   = fx(i,UEDEN)   - Yface*Vci(i)*hface
+             fx(i,UFS+n-1) = fx(i,UFS+n-1) - Yface*Vci(i)
+             fx(i,UEDEN)   = fx(i,UEDEN)   - Yface*Vci(i)*hface
+          end do
        end do
-    end do
-    
+    end if
+
     ! Sscale fluxes by area
     do i=lo(1),hi(1)+1
        fx(i,UMX)   = fx(i,UMX)   * Ax(i)
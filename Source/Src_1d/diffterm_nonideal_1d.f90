@@ -25,7 +25,8 @@ contains
                          deltax) bind(C, name = "pc_diffterm")
 
     use actual_network, only     : nspec
-    use meth_params_module, only : NVAR, UMX, UEDEN, UFS, QVAR, QU, QPRES, QTEMP, QFS, QRHO
+    use meth_params_module, only : NVAR, UMX, UEDEN, UFS, QVAR, QU, QPRES, QTEMP, QFS, QRHO, &
+                                   do_diff_vel, do_diff_ener, do_diff_spec
     use amrex_constants_module
     use eos_type_module
     use eos_module
@@ -72,98 +73,109 @@ contains
        call build(eos_state(i))
     enddo
 
-    do i=lo(1),hi(1)+1
-       ! viscous stress
-       dudx = dxinv(1)*(Q(i,QU) - Q(i-1,QU))
-       divu = dudx
-       tauxx = mux(i)*(2.d0*dudx-twoThirds*divu) + xix(i)*divu
-       uface = HALF*(Q(i,QU)    + Q(i-1,QU))
-       pface = HALF*(Q(i,QPRES) + Q(i-1,QPRES))
-
-       fx(i,UMX)   = -tauxx
-       fx(i,UEDEN) = -tauxx*uface
-
-       ! thermal conduction
-       dTdx = dxinv(1) * (Q(i,QTEMP) - Q(i-1,QTEMP))
-       fx(i,UEDEN) = fx(i,UEDEN) - lamx(i)*dTdx
-
-       ! (1/p)(dp/dx)
-   !    dlnp(i) = dxinv(1) * (Q(i,QPRES) - Q(i-1,QPRES)) / pface
-       gradP(i) = dxinv(1) * (Q(i,QPRES) - Q(i-1,QPRES))
-       Vc(i) = 0.d0
-    end do
+    if (do_diff_vel) then
+       do i=lo(1),hi(1)+1
+          ! viscous stress
+          dudx = dxinv(1)*(Q(i,QU) - Q(i-1,QU))
+          divu = dudx
+          tauxx = mux(i)*(2.d0*dudx-twoThirds*divu) + xix(i)*divu
+          uface = HALF*(Q(i,QU)    + Q(i-1,QU))
 
-    do i=lo(1)-1,hi(1)+1
-       eos_state(i) % massfrac(:) = Q(i,QFS:QFS+nspec-1)
-       eos_state(i) % T           = Q(i,QTEMP)
-       eos_state(i) % rho         = Q(i,QRHO)
-       call eos_ytx(eos_state(i))
-       call eos_hi(eos_state(i))
-       call eos_get_transport(eos_state(i))
-    end do
+          fx(i,UMX)   = -tauxx
+          fx(i,UEDEN) = -tauxx*uface
+       end do
+    end if
 
-      do n=1,nspec
-          do i = lo(1), hi(1)+1
+    if (do_diff_ener) then
+       do i=lo(1),hi(1)+1
+          ! thermal conduction
+          dTdx = dxinv(1) * (Q(i,QTEMP) - Q(i-1,QTEMP))
+          fx(i,UEDEN) = fx(i,UEDEN) - lamx(i)*dTdx
+       end do
+    end if
+
+    if (do_diff_spec) then
+       do i=lo(1),hi(1)+1
+          pface = HALF*(Q(i,QPRES) + Q(i-1,QPRES))
+
+          ! (1/p)(dp/dx)
+      !    dlnp(i) = dxinv(1) * (Q(i,QPRES) - Q(i-1,QPRES)) / pface
+          gradP(i) = dxinv(1) * (Q(i,QPRES) - Q(i-1,QPRES))
+          Vc(i) = 0.d0
+       end do
+
+       do i=lo(1)-1,hi(1)+1
+          eos_state(i) % massfrac(:) = Q(i,QFS:QFS+nspec-1)
+          eos_state(i) % T           = Q(i,QTEMP)
+          eos_state(i) % rho         = Q(i,QRHO)
+          call eos_ytx(eos_state(i))
+          call eos_hi(eos_state(i))
+          call eos_get_transport(eos_state(i))
+       end do
+
+         do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-             gradY(i,n) = dxinv(1) * (eos_state(i)%massfrac(n) - eos_state(i-1)%massfrac(n))
+                gradY(i,n) = dxinv(1) * (eos_state(i)%massfrac(n) - eos_state(i-1)%massfrac(n))
 
 !    put in P term
-             ddrive(i,n) = 0.5d0*(eos_state(i)% diP(n) + eos_state(i-1)% diP(n)) * gradP(i)
+                ddrive(i,n) = 0.5d0*(eos_state(i)% diP(n) + eos_state(i-1)% diP(n)) * gradP(i)
 
+             enddo
           enddo
-       enddo
 
-       do n=1,nspec
-       do nn=1,nspec
-          do i = lo(1), hi(1)+1
+          do n=1,nspec
+          do nn=1,nspec
+             do i = lo(1), hi(1)+1
 
-            ddrive(i,n) = ddrive(i,n)+ 0.5d0* (eos_state(i) % dijY(n,nn) &
-                           + eos_state(i-1) % dijY(n,nn)) * gradY(i,nn)
+               ddrive(i,n) = ddrive(i,n)+ 0.5d0* (eos_state(i) % dijY(n,nn) &
+                              + eos_state(i-1) % dijY(n,nn)) * gradY(i,nn)
 
+             enddo
+          enddo
           enddo
-       enddo
-       enddo
 
-       dsum = 0.d0
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
+          dsum = 0.d0
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-            dsum(i) = dsum(i) + ddrive(i,n)
+               dsum(i) = dsum(i) + ddrive(i,n)
 
+             enddo
           enddo
-       enddo
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-            ddrive(i,n) =  ddrive(i,n) - eos_state(i)%massfrac(n) * dsum(i)
+               ddrive(i,n) =  ddrive(i,n) - eos_state(i)%massfrac(n) * dsum(i)
 
+             enddo
           enddo
-       enddo
 
 
-    ! Get species/enthalpy diffusion, compute correction velocity
-    do n=1,nspec
-       do i = lo(1), hi(1)+1
-          hface = HALF*(eos_state(i)%hi(n)       + eos_state(i-1)%hi(n))
+       ! Get species/enthalpy diffusion, compute correction velocity
+       do n=1,nspec
+          do i = lo(1), hi(1)+1
+             hface = HALF*(eos_state(i)%hi(n)       + eos_state(i-1)%hi(n))
 
-          Vd = -Dx(i,n)*ddrive(i,n)
+             Vd = -Dx(i,n)*ddrive(i,n)
 
-          fx(i,UFS+n-1) = Vd
-          Vc(i) = Vc(i) + Vd
-          fx(i,UEDEN) = fx(i,UEDEN) + Vd*hface
+             fx(i,UFS+n-1) = Vd
+             Vc(i) = Vc(i) + Vd
+             fx(i,UEDEN) = fx(i,UEDEN) + Vd*hface
+          end do
        end do
-    end do
 
-    ! Add correction velocity
-    do n=1,nspec
-       do i = lo(1), hi(1)+1
-          Yface = HALF*(eos_state(i)%massfrac(n) + eos_state(i-1)%massfrac(n))
-          hface = HALF*(eos_state(i)%hi(n)       + eos_state(i-1)%hi(n))
+       ! Add correction velocity
+       do n=1,nspec
+          do i = lo(1), hi(1)+1
+             Yface = HALF*(eos_state(i)%massfrac(n) + eos_state(i-1)%massfrac(n))
+             hface = HALF*(eos_state(i)%hi(n)       + eos_state(i-1)%hi(n))
 
-          fx(i,UFS+n-1) = fx(i,UFS+n-1) - Yface*Vc(i)
-          fx(i,UEDEN)   = fx(i,UEDEN)   - Yface*Vc(i)*hface
+             fx(i,UFS+n-1) = fx(i,UFS+n-1) - Yface*Vc(i)
+             fx(i,UEDEN)   = fx(i,UEDEN)   - Yface*Vc(i)*hface
+          end do
        end do
-    end do
+    end if
 
     ! Scale fluxes by area
     do i=lo(1),hi(1)+1
@@ -391,7 +391,7 @@ contains
     integer :: i,j,L,n
     integer :: nbr(-1:1,-1:1)
     
-    logical, intent(in) :: as_crse, as_fine
+    integer, intent(in) :: as_crse, as_fine
     integer, intent(in), dimension(2) :: rdclo,rdchi,rfclo,rfchi,dflo,dfhi,lmlo,lmhi
     real(amrex_real), intent(inout) :: rr_drho_crse(rdclo(1):rdchi(1),rdclo(2):rdchi(2),nc)
     real(amrex_real), intent(out) :: dm_as_fine(dflo(1):dfhi(1),dflo(2):dfhi(2),nc)
@@ -467,7 +467,7 @@ contains
              !re redistribution book keeping
              as_crse_crse_cell = .false.
              as_crse_covered_cell = .false.
-             if (as_crse) then
+             if (as_crse .eq. 1) then
                   as_crse_crse_cell = is_inside(i,j,lo,hi) .and. &
                            rr_flag_crse(i,j) .eq. crse_fine_boundary_cell
                   as_crse_covered_cell = rr_flag_crse(i,j) .eq. covered_by_fine
@@ -475,7 +475,7 @@ contains
 
              as_fine_valid_cell = .false.  ! valid cells near box boundary
              as_fine_ghost_cell = .false.  ! ghost cells just outside valid region
-             if (as_fine) then
+             if (as_fine .eq. 1) then
                 as_fine_valid_cell = is_inside(i,j,lo,hi)
                 as_fine_ghost_cell = levmsk(i,j) .eq. levmsk_notcovered ! not covered by other grids
              end if
@@ -33,7 +33,8 @@ contains
                          deltax) bind(C, name = "pc_diffterm")
 
     use actual_network, only     : nspec
-    use meth_params_module, only : NVAR, UMX, UMY, UEDEN, UFS, QVAR, QU, QV, QPRES, QTEMP, QFS, QRHO
+    use meth_params_module, only : NVAR, UMX, UMY, UEDEN, UFS, QVAR, QU, QV, QPRES, QTEMP, QFS, QRHO, &
+                                   do_diff_vel, do_diff_ener, do_diff_spec
     use amrex_constants_module
     use eos_type_module
     use eos_module
@@ -108,108 +109,112 @@ contains
 
        gfaci = dxinv(1)
 
-       do i=lo(1),hi(1)+1
-          dTdx = gfaci(i) * (Q(i,j,QTEMP) - Q(i-1,j,QTEMP))
-          dudx = gfaci(i) * (Q(i,j,QU)    - Q(i-1,j,QU))
-          dvdx = gfaci(i) * (Q(i,j,QV)    - Q(i-1,j,QV))
-          dudy = tx(i,j,1)
-          dvdy = tx(i,j,2)
-
-          divu = dudx + dvdy
-          tauxx = mux(i,j)*(2.d0*dudx-twoThirds*divu) + xix(i,j)*divu
-          tauxy = mux(i,j)*(dudy+dvdx)
-
-          Uface(:) = HALF*(Q(i,j,QU:QV) + Q(i-1,j,QU:QV))
-          pface    = HALF*(Q(i,j,QPRES) + Q(i-1,j,QPRES))
-
-          fx(i,j,UMX)   = - tauxx
-
-      !   write(6,*)" in diff x ",i,j,tauxx, mux(i,j),xix(i,j),divu, dxinv(1)
-      !   write(6,*)" in diff x vels ",Q(i,j,QU),Q(i-1,j,QU),Q(i,j,QV),Q(i-1,j,QV)
-      !   stop
-          fx(i,j,UMY)   = - tauxy
-          fx(i,j,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2)
-
-          ! thermal conduction
-          fx(i,j,UEDEN) = fx(i,j,UEDEN) - lamx(i,j)*dTdx
-
-          ! (1/p)(dp/dx)
-          !   dlnp(i) = dxinv(1) * (Q(i,j,QPRES) - Q(i-1,j,QPRES)) / pface
-          gradPi(i) = gfaci(i) * (Q(i,j,QPRES) - Q(i-1,j,QPRES))
-          Vci(i) = 0.d0
-       end do
+       if (do_diff_vel) then
+          do i=lo(1),hi(1)+1
+             dudx = gfaci(i) * (Q(i,j,QU)    - Q(i-1,j,QU))
+             dvdx = gfaci(i) * (Q(i,j,QV)    - Q(i-1,j,QV))
+             dudy = tx(i,j,1)
+             dvdy = tx(i,j,2)
+             divu = dudx + dvdy
+             tauxx = mux(i,j)*(2.d0*dudx-twoThirds*divu) + xix(i,j)*divu
+             tauxy = mux(i,j)*(dudy+dvdx)
+             Uface(:) = HALF*(Q(i,j,QU:QV) + Q(i-1,j,QU:QV))
+             fx(i,j,UMX)   = - tauxx
+         !   write(6,*)" in diff x ",i,j,tauxx, mux(i,j),xix(i,j),divu, dxinv(1)
+         !   write(6,*)" in diff x vels ",Q(i,j,QU),Q(i-1,j,QU),Q(i,j,QV),Q(i-1,j,QV)
+         !   stop
+             fx(i,j,UMY)   = - tauxy
+             fx(i,j,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2)
+          end do
+       end if
+       if (do_diff_ener) then
+          do i=lo(1),hi(1)+1
+             dTdx = gfaci(i) * (Q(i,j,QTEMP) - Q(i-1,j,QTEMP))
+             ! thermal conduction
+             fx(i,j,UEDEN) = fx(i,j,UEDEN) - lamx(i,j)*dTdx
+          end do
+       end if
+       if (do_diff_spec) then
+          do i=lo(1),hi(1)+1
+             pface    = HALF*(Q(i,j,QPRES) + Q(i-1,j,QPRES))
+             ! (1/p)(dp/dx)
+             !   dlnp(i) = dxinv(1) * (Q(i,j,QPRES) - Q(i-1,j,QPRES)) / pface
+             gradPi(i) = gfaci(i) * (Q(i,j,QPRES) - Q(i-1,j,QPRES))
+             Vci(i) = 0.d0
+          end do
 
-       do i=lo(1)-1,hi(1)+1
-          eos_statei(i) % massfrac(:) = Q(i,j,QFS:QFS+nspec-1)
-          eos_statei(i) % T           = Q(i,j,QTEMP)
-          eos_statei(i) % rho         = Q(i,j,QRHO)
-          call eos_ytx(eos_statei(i))
-          call eos_hi(eos_statei(i))
-          call eos_get_transport(eos_statei(i))
-       end do
+          do i=lo(1)-1,hi(1)+1
+             eos_statei(i) % massfrac(:) = Q(i,j,QFS:QFS+nspec-1)
+             eos_statei(i) % T           = Q(i,j,QTEMP)
+             eos_statei(i) % rho         = Q(i,j,QRHO)
+             call eos_ytx(eos_statei(i))
+             call eos_hi(eos_statei(i))
+             call eos_get_transport(eos_statei(i))
+          end do
 
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-             gradYi(i,n) = gfaci(i) * (eos_statei(i)%massfrac(n) - eos_statei(i-1)%massfrac(n))
+                gradYi(i,n) = gfaci(i) * (eos_statei(i)%massfrac(n) - eos_statei(i-1)%massfrac(n))
 
 !    put in P term
-             ddrivei(i,n) = 0.5d0*(eos_statei(i)% diP(n) + eos_statei(i-1)% diP(n)) * gradPi(i)
+                ddrivei(i,n) = 0.5d0*(eos_statei(i)% diP(n) + eos_statei(i-1)% diP(n)) * gradPi(i)
 
+             enddo
           enddo
-       enddo
 
-       do n=1,nspec
-       do nn=1,nspec
-          do i = lo(1), hi(1)+1
+          do n=1,nspec
+          do nn=1,nspec
+             do i = lo(1), hi(1)+1
 
-            ddrivei(i,n) = ddrivei(i,n)+ 0.5d0* (eos_statei(i) % dijY(n,nn) &
-                           + eos_statei(i-1) % dijY(n,nn)) * gradYi(i,nn)
+               ddrivei(i,n) = ddrivei(i,n)+ 0.5d0* (eos_statei(i) % dijY(n,nn) &
+                              + eos_statei(i-1) % dijY(n,nn)) * gradYi(i,nn)
 
+             enddo
+          enddo
           enddo
-       enddo
-       enddo
 
-       dsumi = 0.d0
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
+          dsumi = 0.d0
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-            dsumi(i) = dsumi(i) + ddrivei(i,n)
+               dsumi(i) = dsumi(i) + ddrivei(i,n)
 
+             enddo
           enddo
-       enddo
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
 
-            ddrivei(i,n) =  ddrivei(i,n) - eos_statei(i)%massfrac(n) * dsumi(i)
+               ddrivei(i,n) =  ddrivei(i,n) - eos_statei(i)%massfrac(n) * dsumi(i)
 
+             enddo
           enddo
-       enddo
 
 
-       ! Get species/enthalpy diffusion, compute correction velocity
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
-             hface = HALF*(eos_statei(i)%hi(n) + eos_statei(i-1)%hi(n))
+          ! Get species/enthalpy diffusion, compute correction velocity
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
+                hface = HALF*(eos_statei(i)%hi(n) + eos_statei(i-1)%hi(n))
 
-             Vd = -Dx(i,j,n)*ddrivei(i,n)
+                Vd = -Dx(i,j,n)*ddrivei(i,n)
              
-             fx(i,j,UFS+n-1) = Vd
-             Vci(i) = Vci(i) + Vd
-             fx(i,j,UEDEN) = fx(i,j,UEDEN) + Vd*hface
+                fx(i,j,UFS+n-1) = Vd
+                Vci(i) = Vci(i) + Vd
+                fx(i,j,UEDEN) = fx(i,j,UEDEN) + Vd*hface
+             end do
           end do
-       end do
 
-       ! Add correction velocity
-       do n=1,nspec
-          do i = lo(1), hi(1)+1
-             Yface = HALF*(eos_statei(i)%massfrac(n) + eos_statei(i-1)%massfrac(n))
-             hface = HALF*(eos_statei(i)%hi(n)       + eos_statei(i-1)%hi(n))
+          ! Add correction velocity
+          do n=1,nspec
+             do i = lo(1), hi(1)+1
+                Yface = HALF*(eos_statei(i)%massfrac(n) + eos_statei(i-1)%massfrac(n))
+                hface = HALF*(eos_statei(i)%hi(n)       + eos_statei(i-1)%hi(n))
 
-             fx(i,j,UFS+n-1) = fx(i,j,UFS+n-1) - Yface*Vci(i)
-             fx(i,j,UEDEN)   = fx(i,j,UEDEN)   - Yface*Vci(i)*hface
+                fx(i,j,UFS+n-1) = fx(i,j,UFS+n-1) - Yface*Vci(i)
+                fx(i,j,UEDEN)   = fx(i,j,UEDEN)   - Yface*Vci(i)*hface
+             end do
           end do
-       end do
+       end if
     end do
 
     ! Scale fluxes by area
@@ -235,52 +240,53 @@ contains
 
        gfacj = dxinv(2)
 
-       do j=lo(2),hi(2)+1
-          dTdy = gfacj(j) * (Q(i,j,QTEMP) - Q(i,j-1,QTEMP))
-          dudy = gfacj(j) * (Q(i,j,QU)    - Q(i,j-1,QU))
-          dvdy = gfacj(j) * (Q(i,j,QV)    - Q(i,j-1,QV))
-          dudx = ty(i,j,1)
-          dvdx = ty(i,j,2)
-
-          divu = dudx + dvdy
-          tauyx = muy(i,j)*(dudy+dvdx)
-          tauyy = muy(i,j)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j)*divu
-
-          Uface(:) = HALF*(Q(i,j,QU:QV) + Q(i,j-1,QU:QV))
-          pface    = HALF*(Q(i,j,QPRES) + Q(i,j-1,QPRES))
-
-          fy(i,j,UMX)   = - tauyx
-          fy(i,j,UMY)   = - tauyy
-          fy(i,j,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2)
-
-          ! thermal conduction
-          fy(i,j,UEDEN) = fy(i,j,UEDEN) - lamy(i,j)*dTdy
-
-          ! (1/p)(dp/dy)
-          !  dlnp(j) = dxinv(2) * (Q(i,j,QPRES) - Q(i,j-1,QPRES)) / pface
-          gradPj(j) = gfacj(j) * (Q(i,j,QPRES) - Q(i,j-1,QPRES))
-          Vcj(j) = 0.d0
-!           if(i.eq.1.and. j.eq.207)then
-!                write(6,*)" in diffterm ",j,Q(i,j,QTEMP), muy(i,j), xiy(i,j), lamy(i,j)
-!           endif
-       end do
+       if (do_diff_vel) then
+          do j=lo(2),hi(2)+1
+             dudy = gfacj(j) * (Q(i,j,QU)    - Q(i,j-1,QU))
+             dvdy = gfacj(j) * (Q(i,j,QV)    - Q(i,j-1,QV))
+             dudx = ty(i,j,1)
+             dvdx = ty(i,j,2)
+             divu = dudx + dvdy
+             tauyx = muy(i,j)*(dudy+dvdx)
+             tauyy = muy(i,j)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j)*divu
+             Uface(:) = HALF*(Q(i,j,QU:QV) + Q(i,j-1,QU:QV))
+             fy(i,j,UMX)   = - tauyx
+             fy(i,j,UMY)   = - tauyy
+             fy(i,j,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2)
+          end do
+       end if
+       if (do_diff_ener) then
+          do j=lo(2),hi(2)+1
+             dTdy = gfacj(j) * (Q(i,j,QTEMP) - Q(i,j-1,QTEMP))
+             ! thermal conduction
+             fy(i,j,UEDEN) = fy(i,j,UEDEN) - lamy(i,j)*dTdy
+          end do
+       end if
+       if (do_diff_spec) then
+          do j=lo(2),hi(2)+1
+             pface    = HALF*(Q(i,j,QPRES) + Q(i,j-1,QPRES))
+             ! (1/p)(dp/dy)
+             !  dlnp(j) = dxinv(2) * (Q(i,j,QPRES) - Q(i,j-1,QPRES)) / pface
+             gradPj(j) = gfacj(j) * (Q(i,j,QPRES) - Q(i,j-1,QPRES))
+             Vcj(j) = 0.d0
+          end do
 
-       do j=lo(2)-1,hi(2)+1
-          eos_statej(j) % massfrac(:) = Q(i,j,QFS:QFS+nspec-1)
-          eos_statej(j) % T           = Q(i,j,QTEMP)
-          eos_statej(j) % rho         = Q(i,j,QRHO)
-          call eos_ytx(eos_statej(j))
-          call eos_hi(eos_statej(j))
-          call eos_get_transport(eos_statej(j))
-       end do
+          do j=lo(2)-1,hi(2)+1
+             eos_statej(j) % massfrac(:) = Q(i,j,QFS:QFS+nspec-1)
+             eos_statej(j) % T           = Q(i,j,QTEMP)
+             eos_statej(j) % rho         = Q(i,j,QRHO)
+             call eos_ytx(eos_statej(j))
+             call eos_hi(eos_statej(j))
+             call eos_get_transport(eos_statej(j))
+          end do
 
-       do n=1,nspec
-          do j = lo(2), hi(2)+1
+          do n=1,nspec
+             do j = lo(2), hi(2)+1
 
-             gradYj(j,n) = gfacj(j) * (eos_statej(j)%massfrac(n) - eos_statej(j-1)%massfrac(n))
+                gradYj(j,n) = gfacj(j) * (eos_statej(j)%massfrac(n) - eos_statej(j-1)%massfrac(n))
 
 !    put in P term
-             ddrivej(j,n) = 0.5d0*(eos_statej(j)% diP(n) + eos_statej(j-1)% diP(n)) * gradPj(j)
+                ddrivej(j,n) = 0.5d0*(eos_statej(j)% diP(n) + eos_statej(j-1)% diP(n)) * gradPj(j)
 
 !            if(i.eq.1 .and. j.eq.207)then
 !                write(6,*)" in species pterm ",n,ddrive(j,n)
@@ -289,67 +295,68 @@ contains
 !                        + eos_state(j-1)%massfrac(n)* eos_state(j-1)%wbar/(Ru*eos_state(j-1) % T * eos_state(j-1) % rho )) * gradP(j)
 
 
+             enddo
           enddo
-       enddo
 
-       do n=1,nspec
-       do nn=1,nspec
-          do j = lo(2), hi(2)+1
+          do n=1,nspec
+          do nn=1,nspec
+             do j = lo(2), hi(2)+1
 
-            ddrivej(j,n) = ddrivej(j,n)+ 0.5d0* (eos_statej(j) % dijY(n,nn) + eos_statej(j-1) % dijY(n,nn)) * gradYj(j,nn)
+               ddrivej(j,n) = ddrivej(j,n)+ 0.5d0* (eos_statej(j) % dijY(n,nn) + eos_statej(j-1) % dijY(n,nn)) * gradYj(j,nn)
 
+             enddo
+          enddo
           enddo
-       enddo
-       enddo
 
-       dsumj = 0.d0
-       do n=1,nspec
-          do j = lo(2), hi(2)+1
+          dsumj = 0.d0
+          do n=1,nspec
+             do j = lo(2), hi(2)+1
 
-            dsumj(j) = dsumj(j) + ddrivej(j,n)
+               dsumj(j) = dsumj(j) + ddrivej(j,n)
 
+             enddo
           enddo
-       enddo
-       do n=1,nspec
-          do j = lo(2), hi(2)+1
+          do n=1,nspec
+             do j = lo(2), hi(2)+1
 
-            ddrivej(j,n) =  ddrivej(j,n) - eos_statej(j)%massfrac(n) * dsumj(j)
+               ddrivej(j,n) =  ddrivej(j,n) - eos_statej(j)%massfrac(n) * dsumj(j)
 !            if(i.eq.1 .and. j.eq.207)then
 !                write(6,*)" species total ",n,ddrive(j,n), dsum(j)
 !            endif
 
+             enddo
           enddo
-       enddo
 
-       ! Get species/enthalpy diffusion, compute correction velocity
-       do n=1,nspec
-          do j = lo(2), hi(2)+1
-             hface = HALF*(eos_statej(j)%hi(n)       + eos_statej(j-1)%hi(n))
+          ! Get species/enthalpy diffusion, compute correction velocity
+          do n=1,nspec
+             do j = lo(2), hi(2)+1
+                hface = HALF*(eos_statej(j)%hi(n)       + eos_statej(j-1)%hi(n))
 
-             Vd = -Dy(i,j,n)*ddrivej(j,n)
+                Vd = -Dy(i,j,n)*ddrivej(j,n)
              
-             fy(i,j,UFS+n-1) = Vd
-             Vcj(j) = Vcj(j) + Vd
-             fy(i,j,UEDEN) = fy(i,j,UEDEN) + Vd*hface
-   !         if(i.eq.1 .and. j.eq.207)then
-   !             write(6,*)" species diff coeff, vell ",n,Dy(i,j,n),Vd
-   !         endif
+                fy(i,j,UFS+n-1) = Vd
+                Vcj(j) = Vcj(j) + Vd
+                fy(i,j,UEDEN) = fy(i,j,UEDEN) + Vd*hface
+      !         if(i.eq.1 .and. j.eq.207)then
+      !             write(6,*)" species diff coeff, vell ",n,Dy(i,j,n),Vd
+      !         endif
+             end do
           end do
-       end do
 
-       ! Add correction velocity
-       do n=1,nspec
-          do j = lo(2), hi(2)+1
-             Yface = HALF*(eos_statej(j)%massfrac(n) + eos_statej(j-1)%massfrac(n))
-             hface = HALF*(eos_statej(j)%hi(n)       + eos_statej(j-1)%hi(n))
+          ! Add correction velocity
+          do n=1,nspec
+             do j = lo(2), hi(2)+1
+                Yface = HALF*(eos_statej(j)%massfrac(n) + eos_statej(j-1)%massfrac(n))
+                hface = HALF*(eos_statej(j)%hi(n)       + eos_statej(j-1)%hi(n))
 
-             fy(i,j,UFS+n-1) = fy(i,j,UFS+n-1) - Yface*Vcj(j)
-             fy(i,j,UEDEN)   = fy(i,j,UEDEN)   - Yface*Vcj(j)*hface
+                fy(i,j,UFS+n-1) = fy(i,j,UFS+n-1) - Yface*Vcj(j)
+                fy(i,j,UEDEN)   = fy(i,j,UEDEN)   - Yface*Vcj(j)*hface
 !          if(i.eq.1.and.j.eq.207)then
 !                write(6,*)" in species flux ",n, fy(i,j,UFS+n-1)
 !            endif
+             end do
           end do
-       end do
+       end if
     end do
 
     ! Scale fluxes by area
@@ -40,7 +40,8 @@ contains
                          deltax) bind(C, name = "pc_diffterm")
 
     use actual_network, only     : nspec
-    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QW, QPRES, QTEMP, QFS, QRHO
+    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QW, QPRES, QTEMP, QFS, QRHO, &
+                                   do_diff_vel, do_diff_ener, do_diff_spec
     use amrex_constants_module
     use eos_type_module
     use eos_module
@@ -122,75 +123,93 @@ contains
 
     dxinv = 1.d0/deltax
 
-    call eos_ytx_vec(Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QFS:QFS+nspec-1),lo,hi,X,lo,hi,lo,hi,nspec)
-    call eos_hi_vec(Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QFS:QFS+nspec-1),lo,hi,Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QTEMP),lo,hi,hii,lo,hi,lo,hi,nspec)
+    ! Only the flux groups switched on (velocity, energy, species) are
+    ! built; the components of the other groups are left as the caller
+    ! set them (zero).
+    if (do_diff_spec) then
+       call eos_ytx_vec(Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QFS:QFS+nspec-1),lo,hi,X,lo,hi,lo,hi,nspec)
+       call eos_hi_vec(Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QFS:QFS+nspec-1),lo,hi,Q(lo(1)-1:hi(1)+1,lo(2)-1:hi(2)+1,lo(3)-1:hi(3)+1,QTEMP),lo,hi,hii,lo,hi,lo,hi,nspec)
+    end if
 
     gfaci = dxinv(1)
     gfacj = dxinv(2)
     gfack = dxinv(3)
 
-    do k=lo(3),hi(3)
-       do j=lo(2),hi(2)
-          do i=lo(1),hi(1)+1
-             dTdx = gfaci(i) * (Q(i,j,k,QTEMP) - Q(i-1,j,k,QTEMP))
-             dudx = gfaci(i) * (Q(i,j,k,QU)    - Q(i-1,j,k,QU))
-             dvdx = gfaci(i) * (Q(i,j,k,QV)    - Q(i-1,j,k,QV))
-             dwdx = gfaci(i) * (Q(i,j,k,QW)    - Q(i-1,j,k,QW))
-             dudy = tx(i,j,k,1)
-             dvdy = tx(i,j,k,2)
-             dudz = tx(i,j,k,4)
-             dwdz = tx(i,j,k,6)
-             divu = dudx + dvdy + dwdz
-             tauxx = mux(i,j,k)*(2.d0*dudx-twoThirds*divu) + xix(i,j,k)*divu
-             tauxy = mux(i,j,k)*(dudy+dvdx)
-             tauxz = mux(i,j,k)*(dudz+dwdx)
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i-1,j,k,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i-1,j,k,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i-1,j,k,QW))
-             fx(i,j,k,UMX)   = - tauxx
-             fx(i,j,k,UMY)   = - tauxy
-             fx(i,j,k,UMZ)   = - tauxz
-             fx(i,j,k,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2) - tauxz*Uface(3) - lamx(i,j,k)*dTdx
-          enddo
-       enddo
-    enddo
-    do k=lo(3),hi(3)
-       do j=lo(2),hi(2)
-          do i=lo(1),hi(1)+1
-             Vc(i,j,k) = 0.d0
+    if (do_diff_vel) then
+       do k=lo(3),hi(3)
+          do j=lo(2),hi(2)
+             do i=lo(1),hi(1)+1
+                dudx = gfaci(i) * (Q(i,j,k,QU)    - Q(i-1,j,k,QU))
+                dvdx = gfaci(i) * (Q(i,j,k,QV)    - Q(i-1,j,k,QV))
+                dwdx = gfaci(i) * (Q(i,j,k,QW)    - Q(i-1,j,k,QW))
+                dudy = tx(i,j,k,1)
+                dvdy = tx(i,j,k,2)
+                dudz = tx(i,j,k,4)
+                dwdz = tx(i,j,k,6)
+                divu = dudx + dvdy + dwdz
+                tauxx = mux(i,j,k)*(2.d0*dudx-twoThirds*divu) + xix(i,j,k)*divu
+                tauxy = mux(i,j,k)*(dudy+dvdx)
+                tauxz = mux(i,j,k)*(dudz+dwdx)
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i-1,j,k,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i-1,j,k,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i-1,j,k,QW))
+                fx(i,j,k,UMX)   = - tauxx
+                fx(i,j,k,UMY)   = - tauxy
+                fx(i,j,k,UMZ)   = - tauxz
+                fx(i,j,k,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2) - tauxz*Uface(3)
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_ener) then
        do k=lo(3),hi(3)
           do j=lo(2),hi(2)
              do i=lo(1),hi(1)+1
-                pface = HALF*(Q(i,j,k,QPRES) + Q(i-1,j,k,QPRES))
-                dlnpi = gfaci(i) * (Q(i,j,k,QPRES) - Q(i-1,j,k,QPRES)) / pface
-                Xface = HALF*(X(i,j,k,n) + X(i-1,j,k,n))
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i-1,j,k,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n) + hii(i-1,j,k,n))
-                dXdx = gfaci(i) * (X(i,j,k,n) - X(i-1,j,k,n))
-                Vd = -Dx(i,j,k,n)*(dXdx + (Xface - Yface) * dlnpi)
-                Vc(i,j,k) = Vc(i,j,k) + Vd
-                fx(i,j,k,UFS+n-1) = Vd
-                fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) + Vd*hface
-             end do
+                dTdx = gfaci(i) * (Q(i,j,k,QTEMP) - Q(i-1,j,k,QTEMP))
+                fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) - lamx(i,j,k)*dTdx
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_spec) then
        do k=lo(3),hi(3)
           do j=lo(2),hi(2)
              do i=lo(1),hi(1)+1
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i-1,j,k,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n) + hii(i-1,j,k,n))
-                fx(i,j,k,UFS+n-1) = fx(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
-                fx(i,j,k,UEDEN)   = fx(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
-             end do
+                Vc(i,j,k) = 0.d0
+             enddo
           enddo
        enddo
-    enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)+1
+                   pface = HALF*(Q(i,j,k,QPRES) + Q(i-1,j,k,QPRES))
+                   dlnpi = gfaci(i) * (Q(i,j,k,QPRES) - Q(i-1,j,k,QPRES)) / pface
+                   Xface = HALF*(X(i,j,k,n) + X(i-1,j,k,n))
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i-1,j,k,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n) + hii(i-1,j,k,n))
+                   dXdx = gfaci(i) * (X(i,j,k,n) - X(i-1,j,k,n))
+                   Vd = -Dx(i,j,k,n)*(dXdx + (Xface - Yface) * dlnpi)
+                   Vc(i,j,k) = Vc(i,j,k) + Vd
+                   fx(i,j,k,UFS+n-1) = Vd
+                   fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) + Vd*hface
+                end do
+             enddo
+          enddo
+       enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)+1
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i-1,j,k,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n) + hii(i-1,j,k,n))
+                   fx(i,j,k,UFS+n-1) = fx(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
+                   fx(i,j,k,UEDEN)   = fx(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
+                end do
+             enddo
+          enddo
+       enddo
+    end if
     do k=lo(3),hi(3)
        do j=lo(2),hi(2)
           do i=lo(1),hi(1)+1
@@ -201,78 +220,93 @@ contains
           enddo
        enddo
     enddo
-    do n=UFS,UFS+nspec-1
-       do k=lo(3),hi(3)
-          do j=lo(2),hi(2)
-             do i=lo(1),hi(1)+1
-                fx(i,j,k,n) = fx(i,j,k,n) * Ax(i,j,k)
+    if (do_diff_spec) then
+       do n=UFS,UFS+nspec-1
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)+1
+                   fx(i,j,k,n) = fx(i,j,k,n) * Ax(i,j,k)
+                enddo
              enddo
           enddo
        enddo
-    enddo
+    end if
 
-    do k=lo(3),hi(3)
-       do j=lo(2),hi(2)+1
-          do i=lo(1),hi(1)
-             dTdy = gfacj(j) * (Q(i,j,k,QTEMP) - Q(i,j-1,k,QTEMP))
-             dudy = gfacj(j) * (Q(i,j,k,QU)    - Q(i,j-1,k,QU))
-             dvdy = gfacj(j) * (Q(i,j,k,QV)    - Q(i,j-1,k,QV))
-             dwdy = gfacj(j) * (Q(i,j,k,QW)    - Q(i,j-1,k,QW))
-             dudx = ty(i,j,k,1)
-             dvdx = ty(i,j,k,2)
-             dvdz = ty(i,j,k,5)
-             dwdz = ty(i,j,k,6)
-             divu = dudx + dvdy + dwdz
-             tauyx = muy(i,j,k)*(dudy+dvdx)
-             tauyy = muy(i,j,k)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j,k)*divu
-             tauyz = muy(i,j,k)*(dwdy+dvdz)
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j-1,k,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j-1,k,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j-1,k,QW))
-             fy(i,j,k,UMX)   = - tauyx
-             fy(i,j,k,UMY)   = - tauyy
-             fy(i,j,k,UMZ)   = - tauyz
-             fy(i,j,k,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2) - tauyz*Uface(3) - lamy(i,j,k)*dTdy
-          enddo
-       enddo
-    enddo
-    do k=lo(3),hi(3)
-       do j=lo(2),hi(2)+1
-          do i=lo(1),hi(1)
-             Vc(i,j,k) = 0.d0
+    if (do_diff_vel) then
+       do k=lo(3),hi(3)
+          do j=lo(2),hi(2)+1
+             do i=lo(1),hi(1)
+                dudy = gfacj(j) * (Q(i,j,k,QU)    - Q(i,j-1,k,QU))
+                dvdy = gfacj(j) * (Q(i,j,k,QV)    - Q(i,j-1,k,QV))
+                dwdy = gfacj(j) * (Q(i,j,k,QW)    - Q(i,j-1,k,QW))
+                dudx = ty(i,j,k,1)
+                dvdx = ty(i,j,k,2)
+                dvdz = ty(i,j,k,5)
+                dwdz = ty(i,j,k,6)
+                divu = dudx + dvdy + dwdz
+                tauyx = muy(i,j,k)*(dudy+dvdx)
+                tauyy = muy(i,j,k)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j,k)*divu
+                tauyz = muy(i,j,k)*(dwdy+dvdz)
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j-1,k,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j-1,k,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j-1,k,QW))
+                fy(i,j,k,UMX)   = - tauyx
+                fy(i,j,k,UMY)   = - tauyy
+                fy(i,j,k,UMZ)   = - tauyz
+                fy(i,j,k,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2) - tauyz*Uface(3)
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_ener) then
        do k=lo(3),hi(3)
           do j=lo(2),hi(2)+1
              do i=lo(1),hi(1)
-                pface = HALF*(Q(i,j,k,QPRES) + Q(i,j-1,k,QPRES))
-                dlnpj = gfacj(j) * (Q(i,j,k,QPRES) - Q(i,j-1,k,QPRES)) / pface
-                Xface = HALF*(X(i,j,k,n) + X(i,j-1,k,n))
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j-1,k,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n)   + hii(i,j-1,k,n))
-                dXdy = gfacj(j) * (X(i,j,k,n) - X(i,j-1,k,n))
-                Vd = -Dy(i,j,k,n)*(dXdy + (Xface - Yface) * dlnpj)
-                Vc(i,j,k) = Vc(i,j,k) + Vd
-                fy(i,j,k,UFS+n-1) = Vd
-                fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) + Vd*hface
-             end do
+                dTdy = gfacj(j) * (Q(i,j,k,QTEMP) - Q(i,j-1,k,QTEMP))
+                fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) - lamy(i,j,k)*dTdy
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_spec) then
        do k=lo(3),hi(3)
           do j=lo(2),hi(2)+1
              do i=lo(1),hi(1)
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j-1,k,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n) + hii(i,j-1,k,n))
-                fy(i,j,k,UFS+n-1) = fy(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
-                fy(i,j,k,UEDEN)   = fy(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
-             end do
+                Vc(i,j,k) = 0.d0
+             enddo
           enddo
        enddo
-    enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)+1
+                do i=lo(1),hi(1)
+                   pface = HALF*(Q(i,j,k,QPRES) + Q(i,j-1,k,QPRES))
+                   dlnpj = gfacj(j) * (Q(i,j,k,QPRES) - Q(i,j-1,k,QPRES)) / pface
+                   Xface = HALF*(X(i,j,k,n) + X(i,j-1,k,n))
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j-1,k,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n)   + hii(i,j-1,k,n))
+                   dXdy = gfacj(j) * (X(i,j,k,n) - X(i,j-1,k,n))
+                   Vd = -Dy(i,j,k,n)*(dXdy + (Xface - Yface) * dlnpj)
+                   Vc(i,j,k) = Vc(i,j,k) + Vd
+                   fy(i,j,k,UFS+n-1) = Vd
+                   fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) + Vd*hface
+                end do
+             enddo
+          enddo
+       enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)+1
+                do i=lo(1),hi(1)
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j-1,k,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n) + hii(i,j-1,k,n))
+                   fy(i,j,k,UFS+n-1) = fy(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
+                   fy(i,j,k,UEDEN)   = fy(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
+                end do
+             enddo
+          enddo
+       enddo
+    end if
     do k=lo(3),hi(3)
        do j=lo(2),hi(2)+1
           do i=lo(1),hi(1)
@@ -283,78 +317,93 @@ contains
           enddo
        enddo
     enddo
-    do n=UFS,UFS+nspec-1
-       do k=lo(3),hi(3)
-          do j=lo(2),hi(2)+1
-             do i=lo(1),hi(1)
-                fy(i,j,k,n) = fy(i,j,k,n) * Ay(i,j,k)
+    if (do_diff_spec) then
+       do n=UFS,UFS+nspec-1
+          do k=lo(3),hi(3)
+             do j=lo(2),hi(2)+1
+                do i=lo(1),hi(1)
+                   fy(i,j,k,n) = fy(i,j,k,n) * Ay(i,j,k)
+                enddo
              enddo
           enddo
        enddo
-    enddo
+    end if
 
-    do k=lo(3),hi(3)+1
-       do j=lo(2),hi(2)
-          do i=lo(1),hi(1)
-             dTdz = gfack(k) * (Q(i,j,k,QTEMP) - Q(i,j,k-1,QTEMP))
-             dudz = gfack(k) * (Q(i,j,k,QU)    - Q(i,j,k-1,QU))
-             dvdz = gfack(k) * (Q(i,j,k,QV)    - Q(i,j,k-1,QV))
-             dwdz = gfack(k) * (Q(i,j,k,QW)    - Q(i,j,k-1,QW))
-             dudx = tz(i,j,k,1)
-             dwdx = tz(i,j,k,3)
-             dvdy = tz(i,j,k,5)
-             dwdy = tz(i,j,k,6)
-             divu = dudx + dvdy + dwdz
-             tauzx = muz(i,j,k)*(dudz+dwdx)
-             tauzy = muz(i,j,k)*(dvdz+dwdy)
-             tauzz = muz(i,j,k)*(2.d0*dwdz-twoThirds*divu) + xiz(i,j,k)*divu
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j,k-1,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j,k-1,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j,k-1,QW))
-             fz(i,j,k,UMX)   = - tauzx
-             fz(i,j,k,UMY)   = - tauzy
-             fz(i,j,k,UMZ)   = - tauzz
-             fz(i,j,k,UEDEN) = - tauzx*Uface(1) - tauzy*Uface(2) - tauzz*Uface(3) - lamz(i,j,k)*dTdz
-          enddo
-       enddo
-    enddo
-    do k=lo(3),hi(3)+1
-       do j=lo(2),hi(2)
-          do i=lo(1),hi(1)
-             Vc(i,j,k) = 0.d0
+    if (do_diff_vel) then
+       do k=lo(3),hi(3)+1
+          do j=lo(2),hi(2)
+             do i=lo(1),hi(1)
+                dudz = gfack(k) * (Q(i,j,k,QU)    - Q(i,j,k-1,QU))
+                dvdz = gfack(k) * (Q(i,j,k,QV)    - Q(i,j,k-1,QV))
+                dwdz = gfack(k) * (Q(i,j,k,QW)    - Q(i,j,k-1,QW))
+                dudx = tz(i,j,k,1)
+                dwdx = tz(i,j,k,3)
+                dvdy = tz(i,j,k,5)
+                dwdy = tz(i,j,k,6)
+                divu = dudx + dvdy + dwdz
+                tauzx = muz(i,j,k)*(dudz+dwdx)
+                tauzy = muz(i,j,k)*(dvdz+dwdy)
+                tauzz = muz(i,j,k)*(2.d0*dwdz-twoThirds*divu) + xiz(i,j,k)*divu
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j,k-1,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j,k-1,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j,k-1,QW))
+                fz(i,j,k,UMX)   = - tauzx
+                fz(i,j,k,UMY)   = - tauzy
+                fz(i,j,k,UMZ)   = - tauzz
+                fz(i,j,k,UEDEN) = - tauzx*Uface(1) - tauzy*Uface(2) - tauzz*Uface(3)
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_ener) then
        do k=lo(3),hi(3)+1
           do j=lo(2),hi(2)
              do i=lo(1),hi(1)
-                pface = HALF*(Q(i,j,k,QPRES) + Q(i,j,k-1,QPRES))
-                dlnpk = gfack(k) * (Q(i,j,k,QPRES) - Q(i,j,k-1,QPRES)) / pface
-                Xface = HALF*(X(i,j,k,n) + X(i,j,k-1,n))
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j,k-1,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n) + hii(i,j,k-1,n))
-                dXdz = dxinv(3) * (X(i,j,k,n) - X(i,j,k-1,n))
-                Vd = -Dz(i,j,k,n)*(dXdz + (Xface - Yface) * dlnpk)
-                Vc(i,j,k) = Vc(i,j,k) + Vd
-                fz(i,j,k,UFS+n-1) = Vd
-                fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) + Vd*hface
-             end do
+                dTdz = gfack(k) * (Q(i,j,k,QTEMP) - Q(i,j,k-1,QTEMP))
+                fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) - lamz(i,j,k)*dTdz
+             enddo
           enddo
        enddo
-    enddo
-    do n=1,nspec
+    end if
+    if (do_diff_spec) then
        do k=lo(3),hi(3)+1
           do j=lo(2),hi(2)
              do i=lo(1),hi(1)
-                Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j,k-1,QFS+n-1))
-                hface = HALF*(hii(i,j,k,n) + hii(i,j,k-1,n))
-                fz(i,j,k,UFS+n-1) = fz(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
-                fz(i,j,k,UEDEN)   = fz(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
-             end do
+                Vc(i,j,k) = 0.d0
+             enddo
           enddo
        enddo
-    enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)+1
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)
+                   pface = HALF*(Q(i,j,k,QPRES) + Q(i,j,k-1,QPRES))
+                   dlnpk = gfack(k) * (Q(i,j,k,QPRES) - Q(i,j,k-1,QPRES)) / pface
+                   Xface = HALF*(X(i,j,k,n) + X(i,j,k-1,n))
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j,k-1,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n) + hii(i,j,k-1,n))
+                   dXdz = dxinv(3) * (X(i,j,k,n) - X(i,j,k-1,n))
+                   Vd = -Dz(i,j,k,n)*(dXdz + (Xface - Yface) * dlnpk)
+                   Vc(i,j,k) = Vc(i,j,k) + Vd
+                   fz(i,j,k,UFS+n-1) = Vd
+                   fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) + Vd*hface
+                end do
+             enddo
+          enddo
+       enddo
+       do n=1,nspec
+          do k=lo(3),hi(3)+1
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)
+                   Yface = HALF*(Q(i,j,k,QFS+n-1) + Q(i,j,k-1,QFS+n-1))
+                   hface = HALF*(hii(i,j,k,n) + hii(i,j,k-1,n))
+                   fz(i,j,k,UFS+n-1) = fz(i,j,k,UFS+n-1) - Yface*Vc(i,j,k)
+                   fz(i,j,k,UEDEN)   = fz(i,j,k,UEDEN)   - Yface*Vc(i,j,k)*hface
+                end do
+             enddo
+          enddo
+       enddo
+    end if
     do k=lo(3),hi(3)+1
        do j=lo(2),hi(2)
           do i=lo(1),hi(1)
@@ -365,15 +414,17 @@ contains
           enddo
        enddo
     enddo
-    do n=UFS,UFS+nspec-1
-       do k=lo(3),hi(3)+1
-          do j=lo(2),hi(2)
-             do i=lo(1),hi(1)
-                fz(i,j,k,n) = fz(i,j,k,n) * Az(i,j,k)
+    if (do_diff_spec) then
+       do n=UFS,UFS+nspec-1
+          do k=lo(3),hi(3)+1
+             do j=lo(2),hi(2)
+                do i=lo(1),hi(1)
+                   fz(i,j,k,n) = fz(i,j,k,n) * Az(i,j,k)
+                enddo
              enddo
           enddo
        enddo
-    enddo
+    end if
 
     do n=1,NVAR
        do k = lo(3), hi(3)
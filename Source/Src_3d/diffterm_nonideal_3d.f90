@@ -40,7 +40,8 @@ contains
                          deltax) bind(C, name = "pc_diffterm")
 
     use actual_network, only     : nspec
-    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QW, QPRES, QTEMP, QFS, QRHO
+    use meth_params_module, only : NVAR, UMX, UMY, UMZ, UEDEN, UFS, QVAR, QU, QV, QW, QPRES, QTEMP, QFS, QRHO, &
+                                   do_diff_vel, do_diff_ener, do_diff_spec
     use amrex_constants_module
     use eos_type_module
     use eos_module
@@ -141,88 +142,95 @@ contains
 
     do k=lo(3),hi(3)
        do j=lo(2),hi(2)
-          do i=lo(1),hi(1)+1
-             dTdx = gfaci(i) * (Q(i,j,k,QTEMP) - Q(i-1,j,k,QTEMP))
-             dudx = gfaci(i) * (Q(i,j,k,QU)    - Q(i-1,j,k,QU))
-             dvdx = gfaci(i) * (Q(i,j,k,QV)    - Q(i-1,j,k,QV))
-             dwdx = gfaci(i) * (Q(i,j,k,QW)    - Q(i-1,j,k,QW))
-             dudy = tx(i,j,k,1)
-             dvdy = tx(i,j,k,2)
-             dudz = tx(i,j,k,3)
-             dwdz = tx(i,j,k,4)
-
-             divu = dudx + dvdy + dwdz
-             tauxx = mux(i,j,k)*(2.d0*dudx-twoThirds*divu) + xix(i,j,k)*divu
-             tauxy = mux(i,j,k)*(dudy+dvdx)
-             tauxz = mux(i,j,k)*(dudz+dwdx)
-
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i-1,j,k,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i-1,j,k,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i-1,j,k,QW))
-
-             fx(i,j,k,UMX)   = - tauxx
-             fx(i,j,k,UMY)   = - tauxy
-             fx(i,j,k,UMZ)   = - tauxz
-             fx(i,j,k,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2) - tauxz*Uface(3)
-
-             fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) - lamx(i,j,k)*dTdx
-             gradPi(i) = gfaci(i) * (Q(i,j,k,QPRES) - Q(i-1,j,k,QPRES)) 
-             Vci(i) = 0.d0
-          end do
-          do i=lo(1)-1,hi(1)+1
-             eosi(i) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
-             eosi(i) % T           = Q(i,j,k,QTEMP)
-             eosi(i) % rho         = Q(i,j,k,QRHO)
-             call eos_ytx(eosi(i))
-             call eos_hi(eosi(i))
-             call eos_get_transport(eosi(i))
-          end do
-          do n=1,nspec
-             do i = lo(1), hi(1)+1
-                gradYi(i,n) = gfaci(i) * (eosi(i)%massfrac(n) - eosi(i-1)%massfrac(n))
+          if (do_diff_vel) then
+             do i=lo(1),hi(1)+1
+                dudx = gfaci(i) * (Q(i,j,k,QU)    - Q(i-1,j,k,QU))
+                dvdx = gfaci(i) * (Q(i,j,k,QV)    - Q(i-1,j,k,QV))
+                dwdx = gfaci(i) * (Q(i,j,k,QW)    - Q(i-1,j,k,QW))
+                dudy = tx(i,j,k,1)
+                dvdy = tx(i,j,k,2)
+                dudz = tx(i,j,k,3)
+                dwdz = tx(i,j,k,4)
+                divu = dudx + dvdy + dwdz
+                tauxx = mux(i,j,k)*(2.d0*dudx-twoThirds*divu) + xix(i,j,k)*divu
+                tauxy = mux(i,j,k)*(dudy+dvdx)
+                tauxz = mux(i,j,k)*(dudz+dwdx)
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i-1,j,k,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i-1,j,k,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i-1,j,k,QW))
+                fx(i,j,k,UMX)   = - tauxx
+                fx(i,j,k,UMY)   = - tauxy
+                fx(i,j,k,UMZ)   = - tauxz
+                fx(i,j,k,UEDEN) = - tauxx*Uface(1) - tauxy*Uface(2) - tauxz*Uface(3)
+             end do
+          end if
+          if (do_diff_ener) then
+             do i=lo(1),hi(1)+1
+                dTdx = gfaci(i) * (Q(i,j,k,QTEMP) - Q(i-1,j,k,QTEMP))
+                fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) - lamx(i,j,k)*dTdx
+             end do
+          end if
+          if (do_diff_spec) then
+             do i=lo(1),hi(1)+1
+                gradPi(i) = gfaci(i) * (Q(i,j,k,QPRES) - Q(i-1,j,k,QPRES)) 
+                Vci(i) = 0.d0
+             end do
+
+             do i=lo(1)-1,hi(1)+1
+                eosi(i) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
+                eosi(i) % T           = Q(i,j,k,QTEMP)
+                eosi(i) % rho         = Q(i,j,k,QRHO)
+                call eos_ytx(eosi(i))
+                call eos_hi(eosi(i))
+                call eos_get_transport(eosi(i))
+             end do
+             do n=1,nspec
+                do i = lo(1), hi(1)+1
+                   gradYi(i,n) = gfaci(i) * (eosi(i)%massfrac(n) - eosi(i-1)%massfrac(n))
 !    put in P term
-                ddrivei(i,n) = 0.5d0*(eosi(i)% diP(n) + eosi(i-1)% diP(n)) * gradPi(i)
+                   ddrivei(i,n) = 0.5d0*(eosi(i)% diP(n) + eosi(i-1)% diP(n)) * gradPi(i)
+                enddo
              enddo
-          enddo
-          do n=1,nspec
-            do nn=1,nspec
-              do i = lo(1), hi(1)+1
-                ddrivei(i,n) = ddrivei(i,n)+ 0.5d0* (eosi(i) % dijY(n,nn) &
-                             + eosi(i-1) % dijY(n,nn)) * gradYi(i,nn)
-              enddo
-            enddo
-          enddo
-          dsumi = 0.d0
-          do n=1,nspec
-             do i = lo(1), hi(1)+1
-               dsumi(i) = dsumi(i) + ddrivei(i,n)
+             do n=1,nspec
+               do nn=1,nspec
+                 do i = lo(1), hi(1)+1
+                   ddrivei(i,n) = ddrivei(i,n)+ 0.5d0* (eosi(i) % dijY(n,nn) &
+                                + eosi(i-1) % dijY(n,nn)) * gradYi(i,nn)
+                 enddo
+               enddo
              enddo
-          enddo
-          do n=1,nspec
-             do i = lo(1), hi(1)+1
-               ddrivei(i,n) =  ddrivei(i,n) - eosi(i)%massfrac(n) * dsumi(i)
+             dsumi = 0.d0
+             do n=1,nspec
+                do i = lo(1), hi(1)+1
+                  dsumi(i) = dsumi(i) + ddrivei(i,n)
+                enddo
              enddo
-          enddo
-          ! Get species/enthalpy diffusion, compute correction velocity
-          do n=1,nspec
-             do i = lo(1), hi(1)+1
-                hface = HALF*(eosi(i)%hi(n) + eosi(i-1)%hi(n))
-                Vd = -Dx(i,j,k,n)*ddrivei(i,n)
-                fx(i,j,k,UFS+n-1) = Vd
-                Vci(i) = Vci(i) + Vd
-                fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) + Vd*hface
+             do n=1,nspec
+                do i = lo(1), hi(1)+1
+                  ddrivei(i,n) =  ddrivei(i,n) - eosi(i)%massfrac(n) * dsumi(i)
+                enddo
+             enddo
+             ! Get species/enthalpy diffusion, compute correction velocity
+             do n=1,nspec
+                do i = lo(1), hi(1)+1
+                   hface = HALF*(eosi(i)%hi(n) + eosi(i-1)%hi(n))
+                   Vd = -Dx(i,j,k,n)*ddrivei(i,n)
+                   fx(i,j,k,UFS+n-1) = Vd
+                   Vci(i) = Vci(i) + Vd
+                   fx(i,j,k,UEDEN) = fx(i,j,k,UEDEN) + Vd*hface
+                end do
              end do
-          end do
-          ! Add correction velocity
-          do n=1,nspec
-             do i = lo(1), hi(1)+1
-                Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
-                hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
-
-                fx(i,j,k,UFS+n-1) = fx(i,j,k,UFS+n-1) - Yface*Vci(i)
-                fx(i,j,k,UEDEN)   = fx(i,j,k,UEDEN)   - Yface*Vci(i)*hface
+             ! Add correction velocity
+             do n=1,nspec
+                do i = lo(1), hi(1)+1
+                   Yface = HALF*(eosi(i)%massfrac(n) + eosi(i-1)%massfrac(n))
+                   hface = HALF*(eosi(i)%hi(n)       + eosi(i-1)%hi(n))
+
+                   fx(i,j,k,UFS+n-1) = fx(i,j,k,UFS+n-1) - Yface*Vci(i)
+                   fx(i,j,k,UEDEN)   = fx(i,j,k,UEDEN)   - Yface*Vci(i)*hface
+                end do
              end do
-          end do
+          end if
        end do
     end do
     
@@ -249,94 +257,102 @@ contains
 
     do k=lo(3),hi(3)
        do i=lo(1),hi(1)
-          do j=lo(2),hi(2)+1
-             dTdy = gfacj(j) * (Q(i,j,k,QTEMP) - Q(i,j-1,k,QTEMP))
-             dudy = gfacj(j) * (Q(i,j,k,QU)    - Q(i,j-1,k,QU))
-             dvdy = gfacj(j) * (Q(i,j,k,QV)    - Q(i,j-1,k,QV))
-             dwdy = gfacj(j) * (Q(i,j,k,QW)    - Q(i,j-1,k,QW))
-             dudx = ty(i,j,k,1)
-             dvdx = ty(i,j,k,2)
-             dvdz = ty(i,j,k,3)
-             dwdz = ty(i,j,k,4)
-
-             divu = dudx + dvdy + dwdz
-             tauyx = muy(i,j,k)*(dudy+dvdx)
-             tauyy = muy(i,j,k)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j,k)*divu
-             tauyz = muy(i,j,k)*(dwdy+dvdz)
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j-1,k,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j-1,k,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j-1,k,QW))
-
-             fy(i,j,k,UMX)   = - tauyx
-             fy(i,j,k,UMY)   = - tauyy
-             fy(i,j,k,UMZ)   = - tauyz
-             fy(i,j,k,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2) - tauyz*Uface(3)
-
-             fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) - lamy(i,j,k)*dTdy
-             gradPj(j) = gfacj(j) * (Q(i,j,k,QPRES) - Q(i,j-1,k,QPRES)) 
-             Vcj(j) = 0.d0
-          end do
-          do j=lo(2)-1,hi(2)+1
-             eosj(j) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
-             eosj(j) % T           = Q(i,j,k,QTEMP)
-             eosj(j) % rho         = Q(i,j,k,QRHO)
-             call eos_ytx(eosj(j))
-             call eos_hi(eosj(j))
-             call eos_get_transport(eosj(j))
-          end do
-          do n=1,nspec
-            do j = lo(2), hi(2)+1
-             gradYj(j,n) = gfacj(j) * (eosj(j)%massfrac(n) - eosj(j-1)%massfrac(n))
+          if (do_diff_vel) then
+             do j=lo(2),hi(2)+1
+                dudy = gfacj(j) * (Q(i,j,k,QU)    - Q(i,j-1,k,QU))
+                dvdy = gfacj(j) * (Q(i,j,k,QV)    - Q(i,j-1,k,QV))
+                dwdy = gfacj(j) * (Q(i,j,k,QW)    - Q(i,j-1,k,QW))
+                dudx = ty(i,j,k,1)
+                dvdx = ty(i,j,k,2)
+                dvdz = ty(i,j,k,3)
+                dwdz = ty(i,j,k,4)
+                divu = dudx + dvdy + dwdz
+                tauyx = muy(i,j,k)*(dudy+dvdx)
+                tauyy = muy(i,j,k)*(2.d0*dvdy-twoThirds*divu) + xiy(i,j,k)*divu
+                tauyz = muy(i,j,k)*(dwdy+dvdz)
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j-1,k,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j-1,k,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j-1,k,QW))
+                fy(i,j,k,UMX)   = - tauyx
+                fy(i,j,k,UMY)   = - tauyy
+                fy(i,j,k,UMZ)   = - tauyz
+                fy(i,j,k,UEDEN) = - tauyx*Uface(1) - tauyy*Uface(2) - tauyz*Uface(3)
+             end do
+          end if
+          if (do_diff_ener) then
+             do j=lo(2),hi(2)+1
+                dTdy = gfacj(j) * (Q(i,j,k,QTEMP) - Q(i,j-1,k,QTEMP))
+                fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) - lamy(i,j,k)*dTdy
+             end do
+          end if
+          if (do_diff_spec) then
+             do j=lo(2),hi(2)+1
+                gradPj(j) = gfacj(j) * (Q(i,j,k,QPRES) - Q(i,j-1,k,QPRES)) 
+                Vcj(j) = 0.d0
+             end do
+
+             do j=lo(2)-1,hi(2)+1
+                eosj(j) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
+                eosj(j) % T           = Q(i,j,k,QTEMP)
+                eosj(j) % rho         = Q(i,j,k,QRHO)
+                call eos_ytx(eosj(j))
+                call eos_hi(eosj(j))
+                call eos_get_transport(eosj(j))
+             end do
+             do n=1,nspec
+               do j = lo(2), hi(2)+1
+                gradYj(j,n) = gfacj(j) * (eosj(j)%massfrac(n) - eosj(j-1)%massfrac(n))
 !    put in P term
-             ddrivej(j,n) = 0.5d0*(eosj(j)% diP(n) + eosj(j-1)% diP(n)) * gradPj(j)
+                ddrivej(j,n) = 0.5d0*(eosj(j)% diP(n) + eosj(j-1)% diP(n)) * gradPj(j)
 !            if(i.eq.1 .and. j.eq.207)then
 !                write(6,*)" in species pterm ",n,ddrivej(j,n)
 !            endif
 !            ddrivej(j,n) = ddrivej(j,n)- 0.5d0*( eosj(j)%massfrac(n)* eosj(j)%wbar/(Ru*eosj(j) % T * eosj(j) % rho ) &
 !                        + eosj(j-1)%massfrac(n)* eosj(j-1)%wbar/(Ru*eosj(j-1) % T * eosj(j-1) % rho )) * gradP(j)
-            enddo
-          enddo
-          do n=1,nspec
-            do nn=1,nspec
-              do j = lo(2), hi(2)+1
-                ddrivej(j,n) = ddrivej(j,n)+ 0.5d0* (eosj(j) % dijY(n,nn) + eosj(j-1) % dijY(n,nn)) * gradYj(j,nn)
-              enddo
-            enddo
-          enddo
-          dsumj = 0.d0
-          do n=1,nspec
-             do j = lo(2), hi(2)+1
-               dsumj(j) = dsumj(j) + ddrivej(j,n)
+               enddo
              enddo
-          enddo
-          do n=1,nspec
-             do j = lo(2), hi(2)+1
-               ddrivej(j,n) =  ddrivej(j,n) - eosj(j)%massfrac(n) * dsumj(j)
+             do n=1,nspec
+               do nn=1,nspec
+                 do j = lo(2), hi(2)+1
+                   ddrivej(j,n) = ddrivej(j,n)+ 0.5d0* (eosj(j) % dijY(n,nn) + eosj(j-1) % dijY(n,nn)) * gradYj(j,nn)
+                 enddo
+               enddo
+             enddo
+             dsumj = 0.d0
+             do n=1,nspec
+                do j = lo(2), hi(2)+1
+                  dsumj(j) = dsumj(j) + ddrivej(j,n)
+                enddo
+             enddo
+             do n=1,nspec
+                do j = lo(2), hi(2)+1
+                  ddrivej(j,n) =  ddrivej(j,n) - eosj(j)%massfrac(n) * dsumj(j)
 !               if(i.eq.1 .and. j.eq.207)then
 !                   write(6,*)" species total ",n,ddrivej(j,n), dsumj(j)
 !               endif
+                enddo
              enddo
-          enddo
-          ! Get species/enthalpy diffusion, compute correction velocity
-          do n=1,nspec
-             do j = lo(2), hi(2)+1
-                hface = HALF*(eosj(j)%hi(n)       + eosj(j-1)%hi(n))
-                Vd = -Dy(i,j,k,n)*ddrivej(j,n)
-                fy(i,j,k,UFS+n-1) = Vd
-                Vcj(j) = Vcj(j) + Vd
-                fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) + Vd*hface
+             ! Get species/enthalpy diffusion, compute correction velocity
+             do n=1,nspec
+                do j = lo(2), hi(2)+1
+                   hface = HALF*(eosj(j)%hi(n)       + eosj(j-1)%hi(n))
+                   Vd = -Dy(i,j,k,n)*ddrivej(j,n)
+                   fy(i,j,k,UFS+n-1) = Vd
+                   Vcj(j) = Vcj(j) + Vd
+                   fy(i,j,k,UEDEN) = fy(i,j,k,UEDEN) + Vd*hface
+                end do
              end do
-          end do
-          ! Add correction velocity
-          do n=1,nspec
-             do j = lo(2), hi(2)+1
-                Yface = HALF*(eosj(j)%massfrac(n) + eosj(j-1)%massfrac(n))
-                hface = HALF*(eosj(j)%hi(n)       + eosj(j-1)%hi(n))
-
-                fy(i,j,k,UFS+n-1) = fy(i,j,k,UFS+n-1) - Yface*Vcj(j)
-                fy(i,j,k,UEDEN)   = fy(i,j,k,UEDEN)   - Yface*Vcj(j)*hface
+             ! Add correction velocity
+             do n=1,nspec
+                do j = lo(2), hi(2)+1
+                   Yface = HALF*(eosj(j)%massfrac(n) + eosj(j-1)%massfrac(n))
+                   hface = HALF*(eosj(j)%hi(n)       + eosj(j-1)%hi(n))
+
+                   fy(i,j,k,UFS+n-1) = fy(i,j,k,UFS+n-1) - Yface*Vcj(j)
+                   fy(i,j,k,UEDEN)   = fy(i,j,k,UEDEN)   - Yface*Vcj(j)*hface
+                end do
              end do
-          end do
+          end if
        end do
     end do
     ! Sscale fluxes by area
@@ -362,85 +378,93 @@ contains
 
     do j=lo(2),hi(2)
        do i=lo(1),hi(1)
-          do k=lo(3),hi(3)+1
-             dTdz = gfack(k) * (Q(i,j,k,QTEMP) - Q(i,j,k-1,QTEMP))
-             dudz = gfack(k) * (Q(i,j,k,QU)    - Q(i,j,k-1,QU))
-             dvdz = gfack(k) * (Q(i,j,k,QV)    - Q(i,j,k-1,QV))
-             dwdz = gfack(k) * (Q(i,j,k,QW)    - Q(i,j,k-1,QW))
-             dudx = tz(i,j,k,1)
-             dwdx = tz(i,j,k,2)
-             dvdy = tz(i,j,k,3)
-             dwdy = tz(i,j,k,4)
-
-             divu = dudx + dvdy + dwdz
-             tauzx = muz(i,j,k)*(dudz+dwdx)
-             tauzy = muz(i,j,k)*(dvdz+dwdy)
-             tauzz = muz(i,j,k)*(2.d0*dwdz-twoThirds*divu) + xiz(i,j,k)*divu
-             Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j,k-1,QU))
-             Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j,k-1,QV))
-             Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j,k-1,QW))
-
-             fz(i,j,k,UMX)   = - tauzx
-             fz(i,j,k,UMY)   = - tauzy
-             fz(i,j,k,UMZ)   = - tauzz
-             fz(i,j,k,UEDEN) = - tauzx*Uface(1) - tauzy*Uface(2) - tauzz*Uface(3)
-
-             fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) - lamz(i,j,k)*dTdz
-             gradPk(k) = gfack(k) * (Q(i,j,k,QPRES) - Q(i,j,k-1,QPRES)) 
-             Vck(k) = 0.d0
-          end do
-          do k=lo(3)-1,hi(3)+1
-             eosk(k) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
-             eosk(k) % T           = Q(i,j,k,QTEMP)
-             eosk(k) % rho         = Q(i,j,k,QRHO)
-             call eos_ytx(eosk(k))
-             call eos_hi(eosk(k))
-             call eos_get_transport(eosk(k))
-          end do
-          do n=1,nspec
-            do k = lo(3), hi(3)+1
-              gradYk(k,n) = gfack(k) * (eosk(k)%massfrac(n) - eosk(k-1)%massfrac(n))
+          if (do_diff_vel) then
+             do k=lo(3),hi(3)+1
+                dudz = gfack(k) * (Q(i,j,k,QU)    - Q(i,j,k-1,QU))
+                dvdz = gfack(k) * (Q(i,j,k,QV)    - Q(i,j,k-1,QV))
+                dwdz = gfack(k) * (Q(i,j,k,QW)    - Q(i,j,k-1,QW))
+                dudx = tz(i,j,k,1)
+                dwdx = tz(i,j,k,2)
+                dvdy = tz(i,j,k,3)
+                dwdy = tz(i,j,k,4)
+                divu = dudx + dvdy + dwdz
+                tauzx = muz(i,j,k)*(dudz+dwdx)
+                tauzy = muz(i,j,k)*(dvdz+dwdy)
+                tauzz = muz(i,j,k)*(2.d0*dwdz-twoThirds*divu) + xiz(i,j,k)*divu
+                Uface(1) = HALF*(Q(i,j,k,QU) + Q(i,j,k-1,QU))
+                Uface(2) = HALF*(Q(i,j,k,QV) + Q(i,j,k-1,QV))
+                Uface(3) = HALF*(Q(i,j,k,QW) + Q(i,j,k-1,QW))
+                fz(i,j,k,UMX)   = - tauzx
+                fz(i,j,k,UMY)   = - tauzy
+                fz(i,j,k,UMZ)   = - tauzz
+                fz(i,j,k,UEDEN) = - tauzx*Uface(1) - tauzy*Uface(2) - tauzz*Uface(3)
+             end do
+          end if
+          if (do_diff_ener) then
+             do k=lo(3),hi(3)+1
+                dTdz = gfack(k) * (Q(i,j,k,QTEMP) - Q(i,j,k-1,QTEMP))
+                fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) - lamz(i,j,k)*dTdz
+             end do
+          end if
+          if (do_diff_spec) then
+             do k=lo(3),hi(3)+1
+                gradPk(k) = gfack(k) * (Q(i,j,k,QPRES) - Q(i,j,k-1,QPRES)) 
+                Vck(k) = 0.d0
+             end do
+
+             do k=lo(3)-1,hi(3)+1
+                eosk(k) % massfrac(:) = Q(i,j,k,QFS:QFS+nspec-1)
+                eosk(k) % T           = Q(i,j,k,QTEMP)
+                eosk(k) % rho         = Q(i,j,k,QRHO)
+                call eos_ytx(eosk(k))
+                call eos_hi(eosk(k))
+                call eos_get_transport(eosk(k))
+             end do
+             do n=1,nspec
+               do k = lo(3), hi(3)+1
+                 gradYk(k,n) = gfack(k) * (eosk(k)%massfrac(n) - eosk(k-1)%massfrac(n))
 !    put in P term
-              ddrivek(k,n) = 0.5d0*(eosk(k)% diP(n) + eosk(k-1)% diP(n)) * gradPk(k)
-            enddo
-          enddo
-          do n=1,nspec
-            do nn=1,nspec
-              do k = lo(3), hi(3)+1
-                ddrivek(k,n) = ddrivek(k,n)+ 0.5d0* (eosk(k) % dijY(n,nn) + eosk(k-1) % dijY(n,nn)) * gradYk(k,nn)
-              enddo
-            enddo
-          enddo
-          dsumk = 0.d0
-          do n=1,nspec
-             do k = lo(3), hi(3)+1
-               dsumk(k) = dsumk(k) + ddrivek(k,n)
+                 ddrivek(k,n) = 0.5d0*(eosk(k)% diP(n) + eosk(k-1)% diP(n)) * gradPk(k)
+               enddo
              enddo
-          enddo
-          do n=1,nspec
-             do k = lo(3), hi(3)+1
-               ddrivek(k,n) =  ddrivek(k,n) - eosk(k)%massfrac(n) * dsumk(k)
+             do n=1,nspec
+               do nn=1,nspec
+                 do k = lo(3), hi(3)+1
+                   ddrivek(k,n) = ddrivek(k,n)+ 0.5d0* (eosk(k) % dijY(n,nn) + eosk(k-1) % dijY(n,nn)) * gradYk(k,nn)
+                 enddo
+               enddo
              enddo
-          enddo
-          ! Get species/enthalpy diffusion, compute correction velocity
-          do n=1,nspec
-             do k = lo(3), hi(3)+1
-                hface = HALF*(eosk(k)%hi(n)       + eosk(k-1)%hi(n))
-                Vd = -Dz(i,j,k,n)*ddrivek(k,n)
-                fz(i,j,k,UFS+n-1) = Vd
-                Vck(k) = Vck(k) + Vd
-                fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) + Vd*hface
+             dsumk = 0.d0
+             do n=1,nspec
+                do k = lo(3), hi(3)+1
+                  dsumk(k) = dsumk(k) + ddrivek(k,n)
+                enddo
+             enddo
+             do n=1,nspec
+                do k = lo(3), hi(3)+1
+                  ddrivek(k,n) =  ddrivek(k,n) - eosk(k)%massfrac(n) * dsumk(k)
+                enddo
+             enddo
+             ! Get species/enthalpy diffusion, compute correction velocity
+             do n=1,nspec
+                do k = lo(3), hi(3)+1
+                   hface = HALF*(eosk(k)%hi(n)       + eosk(k-1)%hi(n))
+                   Vd = -Dz(i,j,k,n)*ddrivek(k,n)
+                   fz(i,j,k,UFS+n-1) = Vd
+                   Vck(k) = Vck(k) + Vd
+                   fz(i,j,k,UEDEN) = fz(i,j,k,UEDEN) + Vd*hface
+                end do
              end do
-          end do
-          ! Add correction velocity
-          do n=1,nspec
-             do k = lo(3), hi(3)+1
-                Yface = HALF*(eosk(k)%massfrac(n) + eosk(k-1)%massfrac(n))
-                hface = HALF*(eosk(k)%hi(n)       + eosk(k-1)%hi(n))
-                fz(i,j,k,UFS+n-1) = fz(i,j,k,UFS+n-1) - Yface*Vck(k)
-                fz(i,j,k,UEDEN)   = fz(i,j,k,UEDEN)   - Yface*Vck(k)*hface
+             ! Add correction velocity
+             do n=1,nspec
+                do k = lo(3), hi(3)+1
+                   Yface = HALF*(eosk(k)%massfrac(n) + eosk(k-1)%massfrac(n))
+                   hface = HALF*(eosk(k)%hi(n)       + eosk(k-1)%hi(n))
+                   fz(i,j,k,UFS+n-1) = fz(i,j,k,UFS+n-1) - Yface*Vck(k)
+                   fz(i,j,k,UEDEN)   = fz(i,j,k,UEDEN)   - Yface*Vck(k)*hface
+                end do
              end do
-          end do
+          end if
        end do
     end do
 
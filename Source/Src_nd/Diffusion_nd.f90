@@ -245,11 +245,100 @@ contains
 
   end subroutine pc_diffextrap
 
+  subroutine pc_get_transport_coeffs(lo, hi, &
+       massfrac,    mf_lo, mf_hi, &
+       temperature,  t_lo,  t_hi, &
+       density,      r_lo,  r_hi, &
+       D,            D_lo,  D_hi, &
+       mu,          mu_lo, mu_hi, &
+       xi,          xi_lo, xi_hi, &
+       lam,        lam_lo,lam_hi) &
+       bind(C, name="pc_get_transport_coeffs")
+
+    ! Evaluate only the transport coefficients needed by the diffusion
+    ! flux groups that are switched on: rhoD for species, mu and xi for
+    ! velocity, lambda for energy.  Coefficients that are not needed are
+    ! left untouched.
+
+    use amrex_fort_module, only : amrex_real
+    use network, only : nspec
+    use transport_module
+    use meth_params_module, only : do_diff_vel, do_diff_ener, do_diff_spec
+
+    implicit none
+
+    integer         , intent(in   ) ::     lo(3),     hi(3)
+    integer         , intent(in   ) ::  mf_lo(3),  mf_hi(3)
+    integer         , intent(in   ) ::   t_lo(3),   t_hi(3)
+    integer         , intent(in   ) ::   r_lo(3),   r_hi(3)
+    integer         , intent(in   ) ::   D_lo(3),   D_hi(3)
+    integer         , intent(in   ) ::  mu_lo(3),  mu_hi(3)
+    integer         , intent(in   ) ::  xi_lo(3),  xi_hi(3)
+    integer         , intent(in   ) :: lam_lo(3), lam_hi(3)
+    real (amrex_real), intent(in   ) :: massfrac(mf_lo(1):mf_hi(1),mf_lo(2):mf_hi(2),mf_lo(3):mf_hi(3),nspec)
+    real (amrex_real), intent(in   ) :: temperature(t_lo(1):t_hi(1),t_lo(2):t_hi(2),t_lo(3):t_hi(3))
+    real (amrex_real), intent(in   ) :: density(r_lo(1):r_hi(1),r_lo(2):r_hi(2),r_lo(3):r_hi(3))
+    real (amrex_real), intent(inout) :: D(D_lo(1):D_hi(1),D_lo(2):D_hi(2),D_lo(3):D_hi(3),nspec)
+    real (amrex_real), intent(inout) :: mu(mu_lo(1):mu_hi(1),mu_lo(2):mu_hi(2),mu_lo(3):mu_hi(3))
+    real (amrex_real), intent(inout) :: xi(xi_lo(1):xi_hi(1),xi_lo(2):xi_hi(2),xi_lo(3):xi_hi(3))
+    real (amrex_real), intent(inout) :: lam(lam_lo(1):lam_hi(1),lam_lo(2):lam_hi(2),lam_lo(3):lam_hi(3))
+
+    ! local variables
+    integer      :: i, j, k, n, np
+    type(wtr_t)  :: which_trans
+    type(trv_t)  :: coeff
+
+    which_trans % wtr_get_xi    = do_diff_vel
+    which_trans % wtr_get_mu    = do_diff_vel
+    which_trans % wtr_get_lam   = do_diff_ener
+    which_trans % wtr_get_Ddiag = do_diff_spec
+
+    if (.not. (do_diff_vel .or. do_diff_ener .or. do_diff_spec)) return
+
+    np = hi(1)-lo(1)+1
+    call build(coeff,np)
+
+    do k = lo(3),hi(3)
+       do j = lo(2),hi(2)
+
+          do n = 1,nspec
+             do i = 1,np
+                coeff % eos_state(i) % massfrac(n) = massfrac(lo(1)+i-1,j,k,n)
+             end do
+          end do
+          coeff % eos_state(1:np) % T   = temperature(lo(1):hi(1),j,k)
+          coeff % eos_state(1:np) % rho = density(lo(1):hi(1),j,k)
+
+          call transport(which_trans, coeff)
+
+          if (do_diff_vel) then
+             mu(lo(1):hi(1),j,k) = coeff % mu(1:np)
+             xi(lo(1):hi(1),j,k) = coeff % xi(1:np)
+          end if
+          if (do_diff_ener) then
+             lam(lo(1):hi(1),j,k) = coeff % lam(1:np)
+          end if
+          if (do_diff_spec) then
+             do n = 1,nspec
+                D(lo(1):hi(1),j,k,n) = coeff % Ddiag(1:np,n)
+             end do
+          end if
+
+       end do
+    end do
+
+    call destroy(coeff)
+
+  end subroutine pc_get_transport_coeffs
+
   subroutine pc_move_transport_coeffs_to_ec(lo,hi,dlo,dhi, &
        cfab,c_lo,c_hi, &
        efab,e_lo,e_hi, dir, nc, do_harmonic) &
        bind(C, name="pc_move_transport_coeffs_to_ec")
 
+    ! Average the cell-centered coefficients to the faces lo:hi normal to
+    ! dir (face indices, so that a caller can fill any slab of faces).
+
     use prob_params_module, only : physbc_lo, physbc_hi
     use amrex_constants_module
 
@@ -271,7 +360,7 @@ contains
           do n = 1,nc
              do k = lo(3), hi(3)
                 do j = lo(2), hi(2)
-                   do i = lo(1), hi(1)+1
+                   do i = lo(1), hi(1)
                       efab(i,j,k,n) = half*(cfab(i,j,k,n) + cfab(i-1,j,k,n))
                    end do
                 end do
@@ -280,7 +369,7 @@ contains
        else if (dir .EQ. 1) then
           do n = 1,nc
              do k = lo(3), hi(3)
-                do j = lo(2), hi(2)+1
+                do j = lo(2), hi(2)
                    do i = lo(1), hi(1)
                       efab(i,j,k,n) = half*(cfab(i,j,k,n) + cfab(i,j-1,k,n))
                    end do
@@ -289,7 +378,7 @@ contains
           end do
        else if (dir .EQ. 2) then
           do n = 1,nc
-             do k = lo(3), hi(3)+1
+             do k = lo(3), hi(3)
                 do j = lo(2), hi(2)
                    do i = lo(1), hi(1)
                       efab(i,j,k,n) = half*(cfab(i,j,k,n) + cfab(i,j,k-1,n))
@@ -303,7 +392,7 @@ contains
           do n = 1,nc
              do k = lo(3), hi(3)
                 do j = lo(2), hi(2)
-                   do i = lo(1), hi(1)+1
+                   do i = lo(1), hi(1)
                       if ((cfab(i,j,k,n) * cfab(i-1,j,k,n)) .gt.zero) then
                          efab(i,j,k,n) =&
                               2*(cfab(i,j,k,n) * cfab(i-1,j,k,n))&
@@ -318,7 +407,7 @@ contains
        else if (dir .EQ. 1) then
           do n = 1,nc
              do k = lo(3), hi(3)
-                do j = lo(2), hi(2)+1
+                do j = lo(2), hi(2)
                    do i = lo(1), hi(1)
                       if((cfab(i,j,k,n) * cfab(i,j-1,k,n)).gt.zero) then
                          efab(i,j,k,n) =&
@@ -333,7 +422,7 @@ contains
           end do
        else if (dir .EQ. 2) then
           do n = 1,nc
-             do k = lo(3), hi(3)+1
+             do k = lo(3), hi(3)
                 do j = lo(2), hi(2)
                    do i = lo(1), hi(1)
                       if((cfab(i,j,k,n) * cfab(i,j,k-1,n)).gt.zero) then
@@ -0,0 +1,50 @@
+#!/bin/bash
+#
+# Analysis routine of the regression tests that only differ from another
+# test by an algorithmic option (chemistry integrator, tabulation, load
+# balancing, ...): compare the last plotfile of the test with the benchmark
+# of the reference test to a tolerance, with fcompare.
+#
+# Called by regtest.py from the run directory of the test as
+#
+#   compare-to-reference.sh <source_dir> <plotfile>
+#
+# (analysisMainArgs = source_dir).  The benchmarks are looked up in
+# ../../../PeleC-benchmarks (testTopDir/PeleC-benchmarks) and fcompare in
+# the AMReX clone next to the PeleC one, unless PELEC_BENCH_DIR or
+# AMREX_HOME are set.
+
+set -e
+
+source_dir=${1%/}
+plotfile=${2%/}
+test_name=${plotfile%_plt*}
+step=${plotfile##*_plt}
+
+# Reference test and relative tolerance of each test
+case ${test_name} in
+  FIAB-2d-batch)     ref=FIAB-2d;       rtol=1.e-4 ;;
+  FIAB-2d-reduced)   ref=FIAB-2d-batch; rtol=1.e-3 ;;
+  FIAB-2d-jacreuse)  ref=FIAB-2d-batch; rtol=1.e-4 ;;
+  FIAB-2d-isat)      ref=FIAB-2d;       rtol=1.e-3 ;;
+  FIAB-2d-substep)   ref=FIAB-2d;       rtol=1.e-3 ;;
+  FIAB-2d-rebalance) ref=FIAB-2d;       rtol=1.e-12 ;;
+  FIAB-2d-eosrow)    ref=FIAB-2d;       rtol=1.e-8 ;;
+  FIAB-2d-tempnewton) ref=FIAB-2d;      rtol=1.e-6 ;;
+  FIAB-2d-keeptemp)  ref=FIAB-2d;       rtol=1.e-6 ;;
+  FIAB-2d-initrates) ref=FIAB-2d;       rtol=1.e-3 ;;
+  FIAB-2d-activity)  ref=FIAB-2d;       rtol=1.e-4 ;;
+  EB-OblqShock-3d-kernel) ref=EB-OblqShock-3d; rtol=1.e-10 ;;
+  FIAB-mol-2d-overlap) ref=FIAB-mol-2d; rtol=1.e-12 ;;
+  FIAB-mol-2d-tempnewton) ref=FIAB-mol-2d; rtol=1.e-6 ;;
+  *)
+    echo "compare-to-reference.sh: no reference for ${test_name}"
+    exit 1 ;;
+esac
+
+bench_dir=${PELEC_BENCH_DIR:-../../../PeleC-benchmarks}
+amrex_dir=${AMREX_HOME:-${source_dir}/../amrex}
+fcompare=$(ls ${amrex_dir}/Tools/Plotfile/fcompare*.ex | head -n 1)
+
+echo "comparing ${plotfile} with ${ref}_plt${step}, rel_tol = ${rtol}"
+${fcompare} --rel_tol ${rtol} ${bench_dir}/${ref}_plt${step} ${plotfile}